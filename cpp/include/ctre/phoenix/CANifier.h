@@ -79,6 +79,7 @@ public:
 	};
 
 	CANifier(int deviceNumber);
+	~CANifier();
 	CTR_Code SetLEDOutput(double percentOutput, LEDChannel ledChannel);
 	CTR_Code SetGeneralOutput(GeneralPin outputPin, bool outputValue, bool outputEnable);
 	CTR_Code SetGeneralOutputs(int outputBits, int isOutputBits);
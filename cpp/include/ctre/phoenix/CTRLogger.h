@@ -1,15 +1,34 @@
 #include "ctre/phoenix/core/ctre.h"
 #include "ctre/phoenix/core/ErrorCode.h" // CTR_Code
 #include <string>
+#include <stdint.h>
 
 namespace CTRE {
 
+namespace Logging { class BinaryRingLog; }
+
+/**
+ * Log() only records the code, origin, raw return addresses and a timestamp
+ * into a fixed ring.  Symbolizing the stack and writing it out happens on a
+ * background thread started by Open(), so Log() is cheap enough for a loop.
+ * Before Open() (or after Close()) Log() writes synchronously.
+ * Repeats of the same code and origin are rate limited by DiagnosticChannel.
+ */
 class CTRLogger {
 public: 
 	static void Close();
 	static CTR_Code Log(CTR_Code code, std::string origin);
+	static CTR_Code Log(CTR_Code code, int originId);
+	static CTR_Code Log(CTR_Code code, int originId, const char *message);
+	static int Origin(const std::string & origin);
 	static void Open(int language);
+	static uint32_t GetLogCount();
+	static uint32_t GetDropCount();
+	static void SetBinaryLog(Logging::BinaryRingLog *log);
 	//static void Description(CTR_Code code, const char *&shrt, const char *&lng);
+private:
+	static CTR_Code Record(CTR_Code code, int originId, const char *text) __attribute__((noinline));
+	static void WriterLoop();
 };
 
 }
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "ctre/phoenix/MotorControl/IMotorController.h"
+#include "ctre/phoenix/Sensors/PigeonIMU.h"
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+
+namespace CTRE {
+
+namespace Telemetry { class TelemetryReplay; }
+
+/**
+ * Per-tick snapshot of device signals.
+ *
+ * Each registered device is read once per Refresh() into a contiguous table,
+ * and every consumer in that tick reads the table instead of the driver.
+ * Schedulers given a cache with SetDeviceCache() refresh it before running
+ * their loopables, so all of them see the same, coherent values.
+ *
+ * Register devices before the schedulers start, Add() is not thread safe
+ * against Refresh().
+ */
+class DeviceCache {
+public:
+	typedef int Handle;
+
+	/** Motor controller signals to read on each refresh, OR together. */
+	enum MotorField {
+		Position = 1 << 0,
+		Velocity = 1 << 1,
+		OutputCurrent = 1 << 2,
+		BusVoltage = 1 << 3,
+		OutputPercent = 1 << 4,
+		Temperature = 1 << 5,
+		AllMotorFields = (1 << 6) - 1,
+	};
+
+	struct Stats {
+		uint64_t refreshes;
+		uint64_t driverCalls;	//!< device reads made by Refresh()
+		uint64_t cachedReads;	//!< consumer reads served from the table
+	};
+
+	DeviceCache();
+
+	Handle Add(CTRE::PigeonIMU *pigeon);
+	Handle Add(CTRE::MotorControl::IMotorController *motorController, int fields = AllMotorFields);
+	Handle Find(CTRE::PigeonIMU *pigeon);
+	Handle Find(CTRE::MotorControl::IMotorController *motorController);
+
+	void Refresh();
+	void SetReplay(bool replay);
+	bool IsReplay();
+
+	int GetPigeonCount();
+	int GetMotorCount();
+	CTRE::PigeonIMU * GetPigeonDevice(Handle pigeon);
+	CTRE::MotorControl::IMotorController * GetMotorDevice(Handle motor);
+
+	/* Pigeon, same signatures as PigeonIMU with the handle first */
+	int GetYawPitchRoll(Handle pigeon, double ypr[3]);
+	int GetRawGyro(Handle pigeon, double xyz_dps[3]);
+	CTRE::PigeonIMU::PigeonState GetState(Handle pigeon);
+
+	/* Motor controllers, same signatures as IMotorController with the handle first */
+	int GetSelectedSensorPosition(Handle motor);
+	int GetSelectedSensorVelocity(Handle motor);
+	ErrorCode GetOutputCurrent(Handle motor, float & param);
+	ErrorCode GetBusVoltage(Handle motor, float & param);
+	ErrorCode GetMotorOutputPercent(Handle motor, float & param);
+	ErrorCode GetTemperature(Handle motor, float & param);
+
+	void GetStats(Stats & stats);
+	int64_t GetCallsSaved();
+	void ResetStats();
+
+private:
+	/* replay writes recorded values straight into the snapshots */
+	friend class CTRE::Telemetry::TelemetryReplay;
+
+	struct PigeonSnapshot {
+		double ypr[3];
+		double rawGyro[3];
+		int yprError;
+		int gyroError;
+		CTRE::PigeonIMU::PigeonState state;
+	};
+	struct MotorSnapshot {
+		int position;
+		int velocity;
+		float outputCurrent;
+		float busVoltage;
+		float outputPercent;
+		float temperature;
+		ErrorCode currentError;
+		ErrorCode voltageError;
+		ErrorCode percentError;
+		ErrorCode temperatureError;
+	};
+	/* devices and their snapshots at the same index */
+	std::vector<CTRE::PigeonIMU*> _pigeonDevices;
+	std::vector<PigeonSnapshot> _pigeons;
+	std::vector<CTRE::MotorControl::IMotorController*> _motorDevices;
+	std::vector<int> _motorFields;
+	std::vector<MotorSnapshot> _motors;
+
+	bool _replay = false;
+
+	std::atomic<uint64_t> _refreshes;
+	std::atomic<uint64_t> _driverCalls;
+	std::atomic<uint64_t> _cachedReads;
+
+	void CountRead() {
+		_cachedReads.fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+/**
+ * Reads one Pigeon through a DeviceCache when attached, else straight from the device.
+ * Lets a loopable opt into the cache without changing how it reads.
+ */
+class CachedPigeon {
+public:
+	CachedPigeon(CTRE::PigeonIMU *pigeon = nullptr) {
+		_pigeon = pigeon;
+	}
+	/** Read through this cache from now on, nullptr to read the device directly. */
+	void Attach(DeviceCache *cache) {
+		_cache = cache;
+		if (cache != nullptr)
+			_handle = cache->Add(_pigeon);
+	}
+	int GetYawPitchRoll(double ypr[3]) {
+		if (_cache != nullptr)
+			return _cache->GetYawPitchRoll(_handle, ypr);
+		return _pigeon->GetYawPitchRoll(ypr);
+	}
+	int GetRawGyro(double xyz_dps[3]) {
+		if (_cache != nullptr)
+			return _cache->GetRawGyro(_handle, xyz_dps);
+		return _pigeon->GetRawGyro(xyz_dps);
+	}
+	CTRE::PigeonIMU::PigeonState GetState() {
+		if (_cache != nullptr)
+			return _cache->GetState(_handle);
+		return _pigeon->GetState();
+	}
+private:
+	CTRE::PigeonIMU *_pigeon;
+	DeviceCache *_cache = nullptr;
+	DeviceCache::Handle _handle = -1;
+};
+
+} // namespace CTRE
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ctre/phoenix/core/ErrorCode.h" // CTR_Code
+#include <string>
+#include <stdint.h>
+
+namespace CTRE {
+
+/**
+ * Coalesces repeated reports of the same (CTR_Code, origin) pair.
+ *
+ * Every occurrence is counted, but a pair is only passed on to the driver
+ * station or the logger once per rate limit period.  The next message that
+ * does get through says how many were held back in between.  The check is a
+ * hash into a fixed table with no locking or allocation, so reporting from
+ * inside a loop every tick is fine.
+ *
+ * Origins are the same ids CTRLogger uses, see Origin().
+ */
+class DiagnosticChannel {
+public:
+	struct Summary {
+		CTR_Code code;
+		int originId;
+		uint32_t count;			//!< every report of this pair
+		uint32_t suppressed;	//!< reports held back since the last one passed
+	};
+
+	static int Origin(const std::string & origin);
+
+	static bool Allow(CTR_Code code, int originId, uint32_t & suppressed);
+	static CTR_Code Report(CTR_Code code, int originId);
+	static CTR_Code SendError(CTR_Code code, int originId, const char *details);
+
+	static void SetDefaultPeriodMs(int periodMs);
+	static void SetPeriodMs(CTR_Code code, int originId, int periodMs);
+
+	static int GetSummaries(Summary *summaries, int capacity);
+	static uint32_t GetOverflowCount();
+	static void Reset();
+};
+
+} // namespace CTRE
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ctre/phoenix/Motion/Pose2d.h"
+#include "ctre/phoenix/MotorControl/IMotorController.h"
+#include "ctre/phoenix/Sensors/PigeonIMU.h"
+#include "ctre/phoenix/Signals/TimeHistory.h"
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include <atomic>
+#include <thread>
+
+namespace CTRE { namespace Drive {
+
+/**
+ * Pose estimator that integrates drivetrain encoder deltas with Pigeon yaw.
+ *
+ * Each Update() reads the encoders and yaw once and integrates the step as a
+ * constant-curvature arc.  Update() may be driven by a scheduler (ILoopable)
+ * or by the built-in thread (StartThread).  The latest pose is published
+ * through a sequence counter so GetPose() never blocks the caller.
+ */
+class Odometry : public CTRE::Tasking::ILoopable {
+public:
+	/**
+	 * Tank drivetrain.
+	 * @param distancePerTick	Distance units per native sensor unit.
+	 */
+	Odometry(CTRE::PigeonIMU *pigeonImu, CTRE::MotorControl::IMotorController *left,
+			CTRE::MotorControl::IMotorController *right, float distancePerTick);
+	/**
+	 * Mecanum drivetrain, all four wheels must be sensored.
+	 * @param distancePerTick	Distance units per native sensor unit.
+	 */
+	Odometry(CTRE::PigeonIMU *pigeonImu, CTRE::MotorControl::IMotorController *leftFront,
+			CTRE::MotorControl::IMotorController *leftRear, CTRE::MotorControl::IMotorController *rightFront,
+			CTRE::MotorControl::IMotorController *rightRear, float distancePerTick);
+	virtual ~Odometry();
+
+	void Update();
+	CTRE::Motion::Pose2d GetPose();
+	CTRE::Motion::Pose2d GetPose(double & timestampSec);
+	void ResetPose(const CTRE::Motion::Pose2d & pose);
+	unsigned int GetUpdateCount();
+
+	void EnableHistory(int capacity);
+	bool GetPoseAt(double timestampSec, CTRE::Motion::Pose2d & pose);
+
+	bool StartThread(int periodUs = 5000);
+	void StopThread();
+
+	/* ILoopable */
+	void OnStart();
+	void OnLoop();
+	bool IsDone();
+	void OnStop();
+
+private:
+	CTRE::PigeonIMU *_pidgey;
+	CTRE::MotorControl::IMotorController *_wheels[4];
+	int _wheelCount;
+	float _distancePerTick;
+
+	/* integrator state, only touched by the updating thread */
+	CTRE::Motion::Pose2d _pose;
+	int _previousTicks[4] = {0, 0, 0, 0};
+	bool _hasBaseline = false;
+	double _yawOffset = 0;	//!< heading = Pigeon yaw + offset
+	bool _yawOffsetPending = false;
+
+	/* published pose, seqlock protected */
+	std::atomic<unsigned int> _seq;
+	std::atomic<double> _pubX;
+	std::atomic<double> _pubY;
+	std::atomic<double> _pubHeading;
+	std::atomic<double> _pubTimestamp;
+
+	/* reset request from another thread */
+	std::atomic<bool> _resetPending;
+	std::atomic<double> _resetX;
+	std::atomic<double> _resetY;
+	std::atomic<double> _resetHeading;
+
+	/* optional pose history for latency compensation */
+	CTRE::Signals::TimeHistory<CTRE::Motion::Pose2d> *_history = nullptr;
+
+	std::atomic<bool> _threadRunning;
+	std::thread _thread;
+
+	void Init();
+	void Publish(double timestampSec);
+	void ThreadLoop(int periodUs);
+};
+
+}}
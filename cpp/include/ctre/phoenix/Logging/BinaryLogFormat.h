@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace CTRE { namespace Logging {
+
+/**
+ * On-disk layout of the binary ring log, shared by the robot side writer
+ * and the host side decoder.  All fields are little endian.
+ *
+ * A log is a fixed set of segment files, each preallocated to
+ * (recordsPerSegment + 1) * kBinaryLogRecordSize bytes.  The first record
+ * sized block of a segment holds its header, the rest hold records.
+ * Record n (counting from zero) lives in segment (n / recordsPerSegment) % segmentCount,
+ * so the ring rotates by arithmetic alone and the oldest segment is overwritten.
+ *
+ * Version 2 stores stack traces as raw addresses instead of symbolized text.
+ */
+static const int kBinaryLogRecordSize = 384;
+static const uint32_t kBinaryLogVersion = 2;
+static const int kBinaryLogMaxFrames = 16;
+static const char kBinaryLogMagic[8] = {'C', 'T', 'R', 'B', 'L', 'O', 'G', '1'};
+
+struct BinaryLogSegmentHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t recordSize;
+	uint32_t recordsPerSegment;
+	uint32_t segmentIndex;
+	uint32_t segmentCount;
+	uint32_t reserved;
+	uint64_t generation;	//!< times the ring has come back around to this segment
+	char pad[kBinaryLogRecordSize - 40];
+};
+
+struct BinaryLogRecord {
+	uint64_t seq;			//!< 1 for the first record ever written, 0 if the slot is empty or mid-write
+	int64_t timestampNs;	//!< Timebase nanoseconds
+	int32_t code;			//!< CTR_Code
+	int32_t hierarchy;
+	uint16_t originLength;
+	uint16_t messageLength;
+	uint16_t frameCount;	//!< entries used in frames
+	uint16_t reserved;
+	uint64_t frames[kBinaryLogMaxFrames];	//!< raw return addresses, symbolized by the decoder
+	char text[kBinaryLogRecordSize - 32 - 8 * kBinaryLogMaxFrames];	//!< origin then message, not terminated
+};
+
+static_assert(sizeof(BinaryLogSegmentHeader) == kBinaryLogRecordSize, "segment header must be one record");
+static_assert(sizeof(BinaryLogRecord) == kBinaryLogRecordSize, "record size mismatch");
+
+}}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "BinaryLogFormat.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace CTRE { namespace Logging {
+
+/**
+ * Fixed-size binary log records written into preallocated, memory mapped
+ * segment files.  Writing a record is a copy into mapped memory, and
+ * rotating to the next segment needs no file system calls at all.
+ * Several threads may Write() at once.
+ *
+ * Decode the segments on a host with cpp/tools/ctr_log_decode.cpp.
+ */
+class BinaryRingLog {
+public:
+	BinaryRingLog();
+	~BinaryRingLog();
+
+	bool Open(const std::string & directory, int segmentCount = 4, int recordsPerSegment = 4096);
+	void Close();
+	bool IsOpen();
+
+	bool Write(int32_t code, int32_t hierarchy, int64_t timestampNs, const char *origin, const char *message,
+			void * const *frames = nullptr, int frameCount = 0);
+	void Flush();
+
+	uint64_t GetRecordCount();
+
+	static std::string SegmentPath(const std::string & directory, int segmentIndex);
+
+private:
+	struct Segment {
+		int fd;
+		BinaryLogSegmentHeader *header;
+		BinaryLogRecord *records;
+		size_t length;
+	};
+	std::vector<Segment> _segments;
+	int _recordsPerSegment = 0;
+	/* next record number to hand out, record n is stored with seq n + 1 */
+	std::atomic<uint64_t> _next;
+
+	bool OpenSegment(const std::string & directory, int segmentIndex, Segment & segment);
+};
+
+}}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ServoParameters.h"
+
+namespace CTRE { namespace Motion {
+
+/**
+ * PID plus feedforward on a single loop.
+ * D acts on the measurement rather than the error so setpoint steps do not kick,
+ * which matches how the Servo loopables have always used it.
+ */
+class PIDController{
+public:
+	void Reset();
+	float Calculate(const ServoParameters & params, float setpoint, float measurement, float dt, float maxOutput);
+	float Calculate(const ServoParameters & params, float setpoint, float measurement, float measurementRate, float dt, float maxOutput);
+	float GetIntegral();
+
+private:
+	float _integral = 0;	//!< I term output contribution
+	float _prevMeasurement = 0;
+	float _rate = 0;
+	bool _primed = false;
+};
+
+/**
+ * N PID loops stored structure-of-arrays.
+ * Calculate() is one straight loop with no branches so the compiler can vectorize it.
+ * Fill the gain arrays directly or per lane with SetGains().
+ */
+template <int N>
+class PIDBatch{
+public:
+	alignas(16) float kP[N];
+	alignas(16) float kI[N];
+	alignas(16) float kD[N];
+	alignas(16) float kF[N];
+	alignas(16) float iMax[N];
+	alignas(16) float dFilter[N];
+	alignas(16) float maxOutput[N];
+
+	alignas(16) float integral[N];	//!< I term output contribution
+	alignas(16) float prevMeasurement[N];
+	alignas(16) float rate[N];
+
+	PIDBatch(){
+		for (int i = 0; i < N; ++i) {
+			kP[i] = kI[i] = kD[i] = kF[i] = iMax[i] = dFilter[i] = 0;
+			maxOutput[i] = 1;
+			integral[i] = prevMeasurement[i] = rate[i] = 0;
+		}
+	}
+	void SetGains(int lane, const ServoParameters & params, float laneMaxOutput){
+		kP[lane] = params.P;
+		kI[lane] = params.I;
+		kD[lane] = params.D;
+		kF[lane] = params.F;
+		iMax[lane] = params.IMax;
+		dFilter[lane] = params.DFilter;
+		maxOutput[lane] = laneMaxOutput;
+	}
+	/** Clear integrators and seed the derivative with the current measurements. */
+	void Reset(const float *measurement){
+		for (int i = 0; i < N; ++i) {
+			integral[i] = 0;
+			rate[i] = 0;
+			prevMeasurement[i] = measurement[i];
+		}
+	}
+	void Calculate(const float * __restrict setpoint, const float * __restrict measurement, float dt, float * __restrict output){
+		float invDt = (dt > 0) ? 1.0f / dt : 0;
+		for (int i = 0; i < N; ++i) {
+			float error = setpoint[i] - measurement[i];
+
+			float rawRate = (measurement[i] - prevMeasurement[i]) * invDt;
+			rate[i] = dFilter[i] * rate[i] + (1.0f - dFilter[i]) * rawRate;
+			prevMeasurement[i] = measurement[i];
+
+			/* Accumulate the I contribution itself so the clamp bounds what it can add to the output */
+			float iLimit = (iMax[i] > 0) ? iMax[i] : maxOutput[i];
+			float iTerm = integral[i] + kI[i] * error * dt;
+			iTerm = (iTerm > iLimit) ? iLimit : iTerm;
+			iTerm = (iTerm < -iLimit) ? -iLimit : iTerm;
+			integral[i] = iTerm;
+
+			float out = kP[i] * error + iTerm - kD[i] * rate[i] + kF[i] * setpoint[i];
+			out = (out > maxOutput[i]) ? maxOutput[i] : out;
+			out = (out < -maxOutput[i]) ? -maxOutput[i] : out;
+			output[i] = out;
+		}
+	}
+};
+
+}}
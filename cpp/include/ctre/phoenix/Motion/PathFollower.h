@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ctre/phoenix/Drive/ISmartDrivetrain.h"
+#include "ctre/phoenix/Drive/Styles.h"
+#include "ctre/phoenix/Sensors/PigeonIMU.h"
+#include "ctre/phoenix/Stopwatch.h"
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "Pose2d.h"
+
+namespace CTRE { namespace Motion {
+
+/**
+ * One sample of a time-parameterized path.
+ * Position is in drivetrain distance units, heading in degrees (CCW positive).
+ */
+struct PathPoint {
+	float t;		//!< Seconds since the start of the path.
+	double x;
+	double y;
+	float heading;
+	float velocity;	//!< Forward velocity in distance units per second.
+};
+
+/**
+ * Tracks a time-parameterized path with a Ramsete controller.
+ * Pose is dead-reckoned from drivetrain distance and Pigeon yaw.
+ * The reference search keeps a monotonic segment index, so each loop
+ * only advances past segments that have already elapsed.
+ */
+class PathFollower : public CTRE::Tasking::ILoopable{
+public:
+	PathFollower(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Drive::Styles::Smart selectedStyle,
+			const PathPoint *path, int pointCount, float maxVelocity, float trackWidth);
+	void SetPath(const PathPoint *path, int pointCount);
+	void SetGains(float b, float zeta);
+	void SetLookahead(float seconds);
+	void SetTolerance(float positionTolerance);
+	Pose2d GetPose();
+	int GetSegmentIndex();
+	void OnStart();
+	void OnStop();
+	bool IsDone();
+	void OnLoop();
+
+private:
+	CTRE::PigeonIMU *_pidgey;
+	CTRE::Drive::ISmartDrivetrain *_driveTrain;
+	CTRE::Drive::Styles::Smart _selectedStyle;
+	const PathPoint *_path;
+	int _pointCount;
+	int _segment = 0;
+	float _maxVelocity;
+	float _trackWidth;
+	float _b = 2.0f;
+	float _zeta = 0.7f;
+	float _lookahead = 0;
+	float _positionTolerance = 0;
+	Pose2d _pose;
+	float _previousDistance = 0;
+	CTRE::Stopwatch _pathTimer;
+	bool _isDone = false;
+	unsigned char _isGood = 0;
+	unsigned char _state = 0;
+
+	void Sample(float t, PathPoint & reference, float & angularRate);
+	bool Follow(float t);
+};
+
+}}
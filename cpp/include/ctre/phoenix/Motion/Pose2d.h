@@ -0,0 +1,28 @@
+#pragma once
+
+namespace CTRE { namespace Motion {
+
+/**
+ * Planar robot pose.
+ * Position is in the caller's distance units (whatever the drivetrain reports),
+ * heading is in degrees, counter-clockwise positive to match Pigeon yaw.
+ */
+struct Pose2d {
+	double x = 0;
+	double y = 0;
+	double heading = 0;
+
+	/**
+	 * Integrate a robot-relative displacement onto this pose using exact arc
+	 * integration (constant curvature over the step).
+	 * @param forward	Distance travelled along the robot's forward axis.
+	 * @param strafe	Distance travelled along the robot's left axis (zero for tank).
+	 * @param newHeading	Heading in degrees at the end of the step.
+	 */
+	void Integrate(double forward, double strafe, double newHeading);
+
+	/** Wrap an angle in degrees into (-180, 180]. */
+	static double WrapDegrees(double angleDeg);
+};
+
+}}
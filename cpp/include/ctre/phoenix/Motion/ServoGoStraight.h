@@ -4,6 +4,7 @@
 #include "ctre/phoenix/Drive/Styles.h"
 #include "ctre/phoenix/Stopwatch.h"
 #include "ctre/phoenix/Tasking/ILoopable.h"
+#include "PIDController.h"
 #include "ServoParameters.h"
 
 namespace CTRE { namespace Motion {
@@ -34,6 +35,7 @@ private:
 	bool _isRunning = false;
 	bool _isDone = false;
 	unsigned char _state = 0;
+	PIDController _headingPID;
 
 	bool GoStraight(float Y, float targetHeading, float headingTolerance);
 };
@@ -2,9 +2,11 @@
 
 #include "ctre/phoenix/Drive/IDrivetrain.h"
 #include "ctre/phoenix/Drive/Styles.h"
+#include "ctre/phoenix/DeviceCache.h"
 #include "ctre/phoenix/Sensors/PigeonIMU.h"
 #include "ctre/phoenix/Stopwatch.h"
 #include "ctre/phoenix/Tasking/ILoopable.h"
+#include "PIDController.h"
 #include "ServoParameters.h"
 
 
@@ -18,6 +20,7 @@ public:
 	ServoGoStraightWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::IDrivetrain *driveTrain, CTRE::Drive::Styles::Basic selectedStyle);
 	bool Set(float Y, float targetHeading, float headingTolerance, float maxOutput);
 	float GetImuHeading();
+	void SetDeviceCache(CTRE::DeviceCache *cache);
 	void OnStart();
 	void OnStop();
 	bool IsDone();
@@ -25,6 +28,7 @@ public:
 
 private:
     CTRE::PigeonIMU *_pidgey;
+    CTRE::CachedPigeon _imu;
     CTRE::Drive::IDrivetrain *_driveTrain;
     CTRE::Drive::Styles::Basic _selectedStyle;
     float _Y;
@@ -34,6 +38,8 @@ private:
     bool _isRunning = false;
     bool _isDone = false;
     unsigned char _state = 0;
+    CTRE::Stopwatch _myStopwatch;
+    PIDController _headingPID;
 
 	bool GoStraight(float Y, float targetHeading, float headingTolerance);
 };
@@ -2,9 +2,11 @@
 
 #include "ctre/phoenix/Drive/ISmartDrivetrain.h"
 #include "ctre/phoenix/Drive/Styles.h"
+#include "ctre/phoenix/DeviceCache.h"
 #include "ctre/phoenix/Stopwatch.h"
 #include "ctre/phoenix/Sensors/PigeonIMU.h"
 #include "ctre/phoenix/Tasking/ILoopable.h"
+#include "PIDController.h"
 #include "ServoParameters.h"
 
 namespace CTRE { namespace Motion {
@@ -17,6 +19,7 @@ public:
 	ServoGoStraightWithImuSmart(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Drive::Styles::Smart selectedStyle);
 	bool Set(float Y, float targetHeading, float headingTolerance, float maxOutput);
 	float GetImuHeading();
+	void SetDeviceCache(CTRE::DeviceCache *cache);
 	void OnStart();
 	void OnStop();
 	bool IsDone();
@@ -24,6 +27,7 @@ public:
 
 private:
     CTRE::PigeonIMU *_pidgey;
+    CTRE::CachedPigeon _imu;
     CTRE::Drive::ISmartDrivetrain *_driveTrain;
     CTRE::Drive::Styles::Smart _selectedStyle;
     float _Y;
@@ -33,6 +37,8 @@ private:
     bool _isRunning = false;
     bool _isDone = false;
     unsigned char _state = 0;
+    CTRE::Stopwatch _myStopwatch;
+    PIDController _headingPID;
 
 	bool GoStraight(float Y, float targetHeading, float headingTolerance);
 };
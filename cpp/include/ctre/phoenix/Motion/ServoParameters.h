@@ -7,6 +7,9 @@ public:
 	float P = 0;
 	float I = 0;
 	float D = 0;
+	float F = 0;		//!< Feedforward, multiplied by the setpoint.
+	float IMax = 0;		//!< Limit on the I term's output contribution, 0 to limit at the max output.
+	float DFilter = 0;	//!< Derivative smoothing, 0 is unfiltered, closer to 1 is smoother.
 };
 
-}}
\ No newline at end of file
+}}
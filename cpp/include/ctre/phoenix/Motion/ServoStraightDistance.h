@@ -4,6 +4,7 @@
 #include "ctre/phoenix/Drive/Styles.h"
 #include "ctre/phoenix/Tasking/ILoopable.h"
 #include "ServoGoStraight.h"
+#include "PIDController.h"
 #include "ServoParameters.h"
 
 namespace CTRE { namespace Motion {
@@ -39,6 +40,7 @@ private:
     bool _isRunning = false;
     bool _isDone = false;
     unsigned char _state = 0;
+    PIDController _distancePID;
     unsigned char _isGood = 0;
 
 	bool StraightDistance(float targetHeading, float targetDistance, float headingTolerance, float distanceTolerance);
@@ -2,9 +2,11 @@
 
 #include "ctre/phoenix/Drive/ISmartDriveTrain.h"
 #include "ctre/phoenix/Drive/Styles.h"
+#include "ctre/phoenix/DeviceCache.h"
 #include "ctre/phoenix/Sensors/PigeonIMU.h"
 #include "ctre/phoenix/Tasking/ILoopable.h"
 #include "ServoGoStraightWithIMUSmart.h"
+#include "PIDController.h"
 #include "ServoParameters.h"
 
 namespace CTRE { namespace Motion {
@@ -18,6 +20,7 @@ public:
 	ServoStraightDistanceWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::ISmartDrivetrain *drivetrain, CTRE::Drive::Styles::Smart selectedStyle);
 	bool Set(float targetHeading, float targetDistance, float headingTolerance, float distanceTolerance, float maxOutput);
 	float GetImuHeading();
+	void SetDeviceCache(CTRE::DeviceCache *cache);
 	float GetEncoderDistance();
 	void OnStart();
 	void OnStop();
@@ -26,6 +29,7 @@ public:
 
 private:
     CTRE::PigeonIMU *_pidgey;
+    CTRE::CachedPigeon _imu;
     CTRE::Drive::ISmartDrivetrain *_driveTrain;
     CTRE::Drive::Styles::Smart _selectedStyle;
     ServoGoStraightWithImuSmart *StraightDrive;
@@ -40,6 +44,7 @@ private:
     bool _isRunning = false;
     bool _isDone = false;
     unsigned char _state = 0;
+    PIDController _distancePID;
     unsigned char _isGood = 0;
 
 	bool StraightDistance(float targetHeading, float targetDistance, float headingTolerance, float distanceTolerance);
@@ -2,9 +2,11 @@
 
 #include "ctre/phoenix/Drive/ISmartDrivetrain.h"
 #include "ctre/phoenix/Drive/Styles.h"
+#include "ctre/phoenix/DeviceCache.h"
 #include "ctre/phoenix/Stopwatch.h"
 #include "ctre/phoenix/Sensors/PigeonIMU.h"
 #include "ctre/phoenix/Tasking/ILoopable.h"
+#include "PIDController.h"
 #include "ServoParameters.h"
 
 namespace CTRE { namespace Motion {
@@ -18,6 +20,7 @@ public:
 	ServoZeroTurnWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::IDrivetrain *driveTrain, CTRE::Drive::Styles::Basic selectedStyle);
 	bool Set(float targetHeading, float headingTolerance, float maxOutput);
 	float GetImuHeading();
+	void SetDeviceCache(CTRE::DeviceCache *cache);
 	void OnStart();
 	void OnStop();
 	bool IsDone();
@@ -25,6 +28,7 @@ public:
 
 private:
     CTRE::PigeonIMU *_pidgey;
+    CTRE::CachedPigeon _imu;
     CTRE::Drive::IDrivetrain *_driveTrain;
     CTRE::Drive::Styles::Basic _selectedStyle;
     float _targetHeading;
@@ -34,6 +38,8 @@ private:
     bool _isDone = false;
     unsigned char _isGood = 0;
     unsigned char _state = 0;
+    CTRE::Stopwatch _myStopwatch;
+    PIDController _headingPID;
 
 	bool ZeroTurn(float targetHeading, float headingTolerance);
 };
@@ -19,6 +19,9 @@ class MotControllerWithBuffer_LowLevel;
 class MotController_LowLevel;
 }
 }
+namespace Telemetry {
+class ControlLog;
+}
 }
 
 namespace CTRE {
@@ -33,6 +36,7 @@ private:
 	ControlMode m_sendMode = ControlMode::PercentOutput;
 
 	int _arbId = 0;
+	int _diagnosticOrigin = -1;
 	float m_setPoint = 0;
 	bool _invert = false;
 	int m_profile = 0;
@@ -41,6 +45,7 @@ private:
 
 	ErrorCode SetLastError(int error);
 	ErrorCode SetLastError(ErrorCode error);
+	void SendDemand(int mode, int demand0, int demand1);
 
 	frc::SpeedController * _wpilibSpeedController;
 protected:
@@ -50,6 +55,9 @@ public:
 	BaseMotorController(int arbId);
 	~BaseMotorController();
 	int GetDeviceID();
+	static void SetControlLog(CTRE::Telemetry::ControlLog *log);
+	static void SetReplay(bool replay);
+	static bool IsReplay();
 	virtual void Set(float value);
 	virtual void Set(ControlMode Mode, float value);
 	virtual void Set(ControlMode mode, float demand0, float demand1);
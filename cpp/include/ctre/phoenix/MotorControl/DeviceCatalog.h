@@ -1,36 +1,140 @@
 #pragma once
 
 #include "IMotorController.h"
+#include <mutex>
+#include <stdint.h>
 #include <vector>
 
+/* forward proto's */
+namespace CTRE {
+class PigeonIMU;
+class CANifier;
+class DeviceCache;
+}
+
 namespace CTRE {
 namespace MotorControl {
 
+/**
+ * Process wide registry of every CTRE device object.
+ *
+ * BaseMotorController, PigeonIMU and CANifier join on construction and leave
+ * on destruction.  Devices are indexed by type and CAN ID for constant time
+ * lookup, and also kept in contiguous per-type arrays so bulk operations are
+ * a single pass.
+ *
+ * Registration is locked, lookups and the arrays are not: create devices
+ * before handing them to other threads, as is done for DeviceCache.  To walk
+ * the motor controllers while others may come and go, use
+ * ForEachMotorController().
+ */
 class DeviceCatalog {
 public:
-	void Register(IMotorController *motorController) {
-		_mcs.push_back(motorController);
-	}
+	enum DeviceType {
+		TalonSRXType = 0,
+		VictorSPXType = 1,
+		PigeonIMUType = 2,
+		CANifierType = 3,
+		DeviceTypeCount = 4,
+	};
+	/** Groups for ConfigureMotorControllers(), OR together. */
+	enum Group {
+		TalonSRXGroup = 1 << TalonSRXType,
+		VictorSPXGroup = 1 << VictorSPXType,
+		AllMotorControllers = TalonSRXGroup | VictorSPXGroup,
+	};
+	static const int kMaxDeviceId = 63;
+
+	static DeviceCatalog & GetInstance();
+
+	void Register(IMotorController *motorController);
+	void Register(CTRE::PigeonIMU *pigeon, int deviceId);
+	void Register(CTRE::CANifier *canifier, int deviceId);
+	void Unregister(IMotorController *motorController);
+	void Unregister(CTRE::PigeonIMU *pigeon);
+	void Unregister(CTRE::CANifier *canifier);
+
+	IMotorController * FindMotorController(DeviceType type, int deviceId);
+	CTRE::PigeonIMU * FindPigeon(int deviceId);
+	CTRE::CANifier * FindCANifier(int deviceId);
 
 	int MotorControllerCount() {
-		return _mcs.size();
+		return (int) _mcs.size();
 	}
-
 	IMotorController* Get(int idx) {
 		return _mcs[idx];
 	}
+	DeviceType GetMotorControllerType(int idx) {
+		return (DeviceType) _mcTypes[idx];
+	}
+	/** Contiguous array of MotorControllerCount() entries, not locked. */
+	IMotorController * const * GetMotorControllers() {
+		return _mcs.data();
+	}
+	int PigeonCount() {
+		return (int) _pigeons.size();
+	}
+	CTRE::PigeonIMU * const * GetPigeons() {
+		return _pigeons.data();
+	}
+	int CANifierCount() {
+		return (int) _canifiers.size();
+	}
+	CTRE::CANifier * const * GetCANifiers() {
+		return _canifiers.data();
+	}
+
+	void NeutralAll();
+	void RefreshStatus(CTRE::DeviceCache & cache);
 
-	DeviceCatalog & GetInstance() {
-		if (!_instance)
-			_instance = new DeviceCatalog();
-		return *_instance;
+	/**
+	 * Apply a config to every motor controller in the groups, for example
+	 * [](IMotorController *mc) { return mc->ConfigOpenloopRamp(0.2f, 10); }.
+	 * Every controller is visited even if one fails.
+	 * @return first error returned by config, OK if none.
+	 */
+	/**
+	 * Call fn(index, motorController) for every motor controller in catalog
+	 * order.  Runs under the registration lock, so no controller is created
+	 * or destroyed during the pass; fn must not create or destroy devices.
+	 * @return number of controllers visited.
+	 */
+	template <typename Fn>
+	int ForEachMotorController(Fn fn) {
+		std::lock_guard<std::mutex> lock(_lock);
+		int count = (int) _mcs.size();
+		for (int i = 0; i < count; ++i)
+			fn(i, _mcs[i]);
+		return count;
 	}
+
+	template <typename Config>
+	ErrorCode ConfigureMotorControllers(int groups, Config config) {
+		std::lock_guard<std::mutex> lock(_lock);
+		ErrorCode first = OK;
+		for (size_t i = 0; i < _mcs.size(); ++i) {
+			if ((groups & (1 << _mcTypes[i])) == 0)
+				continue;
+			ErrorCode err = config(_mcs[i]);
+			if (first == OK)
+				first = err;
+		}
+		return first;
+	}
+
 private:
+	DeviceCatalog();
+
 	std::vector<IMotorController*> _mcs;
+	std::vector<uint8_t> _mcTypes;
+	std::vector<CTRE::PigeonIMU*> _pigeons;
+	std::vector<CTRE::CANifier*> _canifiers;
+	void *_index[DeviceTypeCount][kMaxDeviceId + 1];
+	std::mutex _lock;
 
-	static DeviceCatalog * _instance;
+	void Index(DeviceType type, int deviceId, void *device);
+	void Unindex(DeviceType type, void *device);
 };
 
 }
 }
-
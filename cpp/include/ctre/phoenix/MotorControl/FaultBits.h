@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ctre/phoenix/MotorControl/Faults.h"
+#include "ctre/phoenix/MotorControl/StickyFaults.h"
+#include <stdint.h>
+
+namespace CTRE {
+namespace MotorControl {
+
+/**
+ * Fault flags packed one bit per field, in Faults / StickyFaults field order.
+ *
+ * Decoded from the motor controller status frames the driver keeps cached,
+ * bit numbers are within the 64 bit frame value of CTRE_Native_CAN_Receive.
+ *
+ *   Flag                 Status_1 (faults)   Status_2 (sticky faults)
+ *   HardwareFailure      48                  -
+ *   UnderVoltage         51                  52
+ *   OverTemp             52                  53
+ *   ForwardLimitSwitch   50                  51
+ *   ReverseLimitSwitch   49                  50
+ *   ForwardSoftLimit     28                  49
+ *   ReverseSoftLimit     27                  48
+ *   MsgOverflow          -                   -
+ *   ResetDuringEn        -                   -
+ *
+ * Flags marked - are not reported by the firmware and always read false.
+ */
+class FaultBits {
+public:
+	enum Bit {
+		HardwareFailure = 1 << 0,
+		UnderVoltage = 1 << 1,
+		OverTemp = 1 << 2,
+		ForwardLimitSwitch = 1 << 3,
+		ReverseLimitSwitch = 1 << 4,
+		ForwardSoftLimit = 1 << 5,
+		ReverseSoftLimit = 1 << 6,
+		MsgOverflow = 1 << 7,
+		ResetDuringEn = 1 << 8,
+		AllFaults = (1 << 9) - 1,
+	};
+	static const int kCount = 9;
+
+	/* Status frame arbitration IDs, OR with the controller's base ID */
+	static const uint32_t kStatus1 = 0x041400;
+	static const uint32_t kStatus2 = 0x041440;
+
+	static uint32_t FromStatus1(uint64_t frame);
+	static uint32_t FromStatus2(uint64_t frame);
+
+	static uint32_t Pack(const Faults & faults);
+	static uint32_t Pack(const StickyFaults & faults);
+	static void Unpack(uint32_t bits, Faults & faults);
+	static void Unpack(uint32_t bits, StickyFaults & faults);
+
+	static const char * Name(int index);
+};
+
+}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+#include "FaultBits.h"
+#include "IMotorController.h"
+#include <stdint.h>
+#include <vector>
+
+namespace CTRE {
+namespace MotorControl {
+
+/**
+ * Watches the faults and sticky faults of every catalogued motor controller.
+ *
+ * Each Process() reads both from the cached status frames (no parameter
+ * requests, no bus traffic), compares them with the previous tick and calls
+ * the handler once per flag that turned on or off.  Flags already set on the
+ * first tick a controller is seen are reported as turning on.
+ *
+ * The handler runs under the DeviceCatalog lock and must not create or
+ * destroy devices.
+ */
+class FaultMonitor: public CTRE::Tasking::IProcessable, public CTRE::Tasking::ILoopable {
+public:
+
+	class IFaultEventHandler {
+		public:
+			virtual ~IFaultEventHandler(){}
+			/**
+			 * @param faultIndex	Flag index, see FaultBits.
+			 * @param sticky		True for a sticky fault.
+			 * @param isSet			True on the rising edge, false on the falling edge.
+			 */
+			virtual void OnFault(IMotorController *motorController, int faultIndex, bool sticky, bool isSet) = 0;
+	};
+
+	/**
+	 * @param faultMask	FaultBits flags to watch, both for faults and sticky faults.
+	 */
+	FaultMonitor(IFaultEventHandler *handler, uint32_t faultMask = FaultBits::AllFaults);
+	virtual ~FaultMonitor() { }
+
+	uint32_t GetFaultBits(IMotorController *motorController);
+	uint32_t GetStickyFaultBits(IMotorController *motorController);
+	uint32_t GetReadErrorCount();
+
+	/* IProcessable */
+	virtual void Process();
+
+	/* ILoopable */
+	virtual void OnStart();
+	virtual void OnLoop();
+	virtual bool IsDone();
+	virtual void OnStop();
+
+private:
+	struct Entry {
+		IMotorController *device;
+		uint32_t faults;
+		uint32_t sticky;
+	};
+	IFaultEventHandler * _handler;
+	uint32_t _faultMask;
+	std::vector<Entry> _entries;
+	std::vector<Entry> _next;	//!< rebuilt each Process(), keeps its capacity
+	uint32_t _readErrors = 0;
+
+	void Poll(Entry & entry);
+	void Dispatch(IMotorController *motorController, uint32_t previous, uint32_t current, bool sticky);
+	Entry * Find(IMotorController *motorController);
+};
+
+}
+}
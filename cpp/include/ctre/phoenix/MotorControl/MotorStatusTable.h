@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "IMotorController.h"
+#include <stdint.h>
+#include <vector>
+
+namespace CTRE {
+namespace MotorControl {
+
+/**
+ * Status of every catalogued motor controller in structure-of-arrays form.
+ *
+ * Each Update() walks DeviceCatalog once and copies the driver's latest status
+ * frame values into one contiguous array per signal, so whole-robot math
+ * (current budget, temperature checks, logging) is a flat loop over floats
+ * instead of a virtual call per controller.  Row i is catalog controller i;
+ * rows shift when controllers are created or destroyed, so look a device up
+ * again with FindRow() after that.
+ *
+ * Update() may be driven by a scheduler (ILoopable).  Read the arrays from
+ * the same thread that updates them.
+ */
+class MotorStatusTable : public CTRE::Tasking::ILoopable {
+public:
+	MotorStatusTable();
+
+	void Update();
+	int GetCount();
+	int FindRow(IMotorController *motorController);
+	IMotorController * GetDevice(int row);
+
+	/* one entry per row */
+	const int32_t * Positions() { return _positions.data(); }
+	const int32_t * Velocities() { return _velocities.data(); }
+	const float * Currents() { return _currents.data(); }
+	const float * Voltages() { return _voltages.data(); }
+	const float * Temperatures() { return _temperatures.data(); }
+	const int64_t * TimestampsNs() { return _timestampsNs.data(); }
+	/** First error reported while reading the row, OK if none. */
+	const ErrorCode * Errors() { return _errors.data(); }
+
+	float TotalCurrent();
+	float MaxTemperature();
+	float MinVoltage();
+
+	/* ILoopable */
+	void OnStart();
+	void OnLoop();
+	bool IsDone();
+	void OnStop();
+
+private:
+	std::vector<IMotorController*> _devices;
+	std::vector<int32_t> _positions;
+	std::vector<int32_t> _velocities;
+	std::vector<float> _currents;
+	std::vector<float> _voltages;
+	std::vector<float> _temperatures;
+	std::vector<int64_t> _timestampsNs;
+	std::vector<ErrorCode> _errors;
+
+	void Resize(int count);
+};
+
+}
+}
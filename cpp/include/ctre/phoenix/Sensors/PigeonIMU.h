@@ -181,6 +181,7 @@ public:
 
 	PigeonIMU(int deviceNumber);
 	PigeonIMU(CTRE::MotorControl::CAN::TalonSRX * talonSrx);
+	~PigeonIMU();
 
 	/**
 	 * General setter to allow for the use of future features, without having to update API.
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <math.h>
+
+namespace CTRE {
+namespace Signals {
+
+/**
+ * Second order filter coefficients, normalized so a0 is 1.
+ * Designs follow the RBJ audio cookbook.
+ */
+struct BiquadCoefficients {
+	float b0 = 1, b1 = 0, b2 = 0;
+	float a1 = 0, a2 = 0;
+
+	static BiquadCoefficients LowPass(float cutoffHz, float sampleHz, float q = 0.70710678f) {
+		float w0 = 2.0f * 3.14159265f * cutoffHz / sampleHz;
+		float cw = cosf(w0);
+		float alpha = sinf(w0) / (2.0f * q);
+		float a0 = 1.0f + alpha;
+		BiquadCoefficients c;
+		c.b0 = (1.0f - cw) * 0.5f / a0;
+		c.b1 = (1.0f - cw) / a0;
+		c.b2 = c.b0;
+		c.a1 = -2.0f * cw / a0;
+		c.a2 = (1.0f - alpha) / a0;
+		return c;
+	}
+	static BiquadCoefficients HighPass(float cutoffHz, float sampleHz, float q = 0.70710678f) {
+		float w0 = 2.0f * 3.14159265f * cutoffHz / sampleHz;
+		float cw = cosf(w0);
+		float alpha = sinf(w0) / (2.0f * q);
+		float a0 = 1.0f + alpha;
+		BiquadCoefficients c;
+		c.b0 = (1.0f + cw) * 0.5f / a0;
+		c.b1 = -(1.0f + cw) / a0;
+		c.b2 = c.b0;
+		c.a1 = -2.0f * cw / a0;
+		c.a2 = (1.0f - alpha) / a0;
+		return c;
+	}
+};
+
+/**
+ * Biquad in transposed direct form II, two state values per filter.
+ */
+class Biquad {
+private:
+	BiquadCoefficients _c;
+	float _z1 = 0;
+	float _z2 = 0;
+public:
+	Biquad(const BiquadCoefficients & coefficients) {
+		_c = coefficients;
+	}
+	float Process(float input) {
+		float y = _c.b0 * input + _z1;
+		_z1 = _c.b1 * input - _c.a1 * y + _z2;
+		_z2 = _c.b2 * input - _c.a2 * y;
+		return y;
+	}
+	void Clear() {
+		_z1 = 0;
+		_z2 = 0;
+	}
+	void SetCoefficients(const BiquadCoefficients & coefficients) {
+		_c = coefficients;
+	}
+};
+
+/**
+ * One biquad design applied to many channels, state stored per channel.
+ * Channels are independent, so Process() vectorizes across them.
+ */
+template <int Channels>
+class BiquadBatch {
+private:
+	BiquadCoefficients _c;
+	alignas(16) float _z1[Channels];
+	alignas(16) float _z2[Channels];
+public:
+	BiquadBatch(const BiquadCoefficients & coefficients) {
+		_c = coefficients;
+		Clear();
+	}
+	void Clear() {
+		for (int i = 0; i < Channels; ++i) {
+			_z1[i] = 0;
+			_z2[i] = 0;
+		}
+	}
+	void Process(const float * __restrict input, float * __restrict output) {
+		const BiquadCoefficients c = _c;
+		for (int i = 0; i < Channels; ++i) {
+			float x = input[i];
+			float y = c.b0 * x + _z1[i];
+			_z1[i] = c.b1 * x - c.a1 * y + _z2[i];
+			_z2[i] = c.b2 * x - c.a2 * y;
+			output[i] = y;
+		}
+	}
+};
+
+} // namespace  Signals
+} // namespace CTRE
@@ -0,0 +1,39 @@
+#pragma once
+
+namespace CTRE {
+namespace Signals {
+
+/**
+ * Holds a boolean until the input has disagreed with it for a number of
+ * consecutive samples, e.g. a limit switch or a current spike flag.
+ */
+class Debouncer {
+private:
+	int _samplesToChange;
+	int _disagree = 0;
+	bool _state;
+public:
+	Debouncer(int samplesToChange, bool initial = false) {
+		_samplesToChange = samplesToChange;
+		_state = initial;
+	}
+	bool Process(bool input) {
+		if (input == _state) {
+			_disagree = 0;
+		} else if (++_disagree >= _samplesToChange) {
+			_state = input;
+			_disagree = 0;
+		}
+		return _state;
+	}
+	void Reset(bool state) {
+		_state = state;
+		_disagree = 0;
+	}
+	bool Get() const {
+		return _state;
+	}
+};
+
+} // namespace  Signals
+} // namespace CTRE
@@ -0,0 +1,76 @@
+#pragma once
+
+namespace CTRE {
+namespace Signals {
+
+/**
+ * First order low pass, y += alpha * (x - y).
+ * Alpha near 1 follows the input closely, near 0 smooths heavily.
+ */
+class ExponentialMovingAverage {
+private:
+	float _alpha;
+	float _y = 0;
+	bool _primed = false;
+public:
+	ExponentialMovingAverage(float alpha) {
+		_alpha = alpha;
+	}
+	float Process(float input) {
+		/* Start from the first sample rather than ramping up from zero */
+		if (_primed == false) {
+			_y = input;
+			_primed = true;
+		}
+		_y += _alpha * (input - _y);
+		return _y;
+	}
+	void Clear() {
+		_y = 0;
+		_primed = false;
+	}
+	void SetAlpha(float alpha) {
+		_alpha = alpha;
+	}
+	float Get() const {
+		return _y;
+	}
+};
+
+/**
+ * ExponentialMovingAverage on many channels at once, e.g. every motor current.
+ * State is stored per channel in one array so Process() vectorizes.
+ */
+template <int Channels>
+class ExponentialMovingAverageBatch {
+private:
+	float _alpha;
+	alignas(16) float _y[Channels];
+public:
+	ExponentialMovingAverageBatch(float alpha) {
+		_alpha = alpha;
+		Clear();
+	}
+	/** Seed every channel with its current value. */
+	void Reset(const float *input) {
+		for (int i = 0; i < Channels; ++i)
+			_y[i] = input[i];
+	}
+	void Clear() {
+		for (int i = 0; i < Channels; ++i)
+			_y[i] = 0;
+	}
+	void Process(const float * __restrict input, float * __restrict output) {
+		const float alpha = _alpha;
+		for (int i = 0; i < Channels; ++i) {
+			_y[i] += alpha * (input[i] - _y[i]);
+			output[i] = _y[i];
+		}
+	}
+	float Get(int channel) const {
+		return _y[channel];
+	}
+};
+
+} // namespace  Signals
+} // namespace CTRE
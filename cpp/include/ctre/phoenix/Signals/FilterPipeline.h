@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace CTRE {
+namespace Signals {
+
+/**
+ * Runs a sample through several filters in order, each stage's output
+ * feeding the next.  Stages are held by value and called directly, e.g.
+ *
+ *	FilterPipeline<MovingMedian<5>, Biquad, SlewRateLimiter> current(
+ *		MovingMedian<5>(), Biquad(BiquadCoefficients::LowPass(10, 100)), SlewRateLimiter(0.5f));
+ *
+ * Any stage with a Process() member taking and returning the sample type works.
+ */
+template <typename... Stages>
+class FilterPipeline {
+private:
+	std::tuple<Stages...> _stages;
+
+	template <typename T>
+	T Run(T x, std::integral_constant<std::size_t, sizeof...(Stages)>) {
+		return x;
+	}
+	template <typename T, std::size_t I>
+	T Run(T x, std::integral_constant<std::size_t, I>) {
+		return Run(std::get<I>(_stages).Process(x), std::integral_constant<std::size_t, I + 1>());
+	}
+public:
+	FilterPipeline(const Stages &... stages) :
+			_stages(stages...) {
+	}
+	float Process(float input) {
+		return Run(input, std::integral_constant<std::size_t, 0>());
+	}
+	/** Access a stage, e.g. to retune it. */
+	template <std::size_t I>
+	typename std::tuple_element<I, std::tuple<Stages...> >::type & Stage() {
+		return std::get<I>(_stages);
+	}
+};
+
+} // namespace  Signals
+} // namespace CTRE
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <string.h>
+
+namespace CTRE {
+namespace Signals {
+
+/**
+ * Moving average with the capacity fixed at compile time and stored inline.
+ * Capacity must be a power of two so ring indices wrap with a mask.
+ * The running sum is Kahan compensated so it does not drift over a long match.
+ */
+template <int Capacity>
+class FixedMovingAverage {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "FixedMovingAverage capacity must be a power of two");
+private:
+	static const unsigned int kMask = Capacity - 1;
+
+	float _d[Capacity]; //!< ring buffer
+	unsigned int _in; //!< head ptr for ringbuffer, wrapped with kMask
+	int _cnt; //!< number of element in ring buffer
+	float _sum; //!< sum of all elements in ring buffer
+	float _comp; //!< Kahan compensation, low order bits lost from _sum
+
+	void Accumulate(float d) {
+		float y = d - _comp;
+		float t = _sum + y;
+		_comp = (t - _sum) - y;
+		_sum = t;
+	}
+	/* Four independent partial sums so the loop can be vectorized without reassociating */
+	static float SumBlock(const float *d, int count) {
+		float acc[4] = { 0, 0, 0, 0 };
+		int i = 0;
+		for (; i + 4 <= count; i += 4) {
+			acc[0] += d[i + 0];
+			acc[1] += d[i + 1];
+			acc[2] += d[i + 2];
+			acc[3] += d[i + 3];
+		}
+		for (; i < count; ++i)
+			acc[0] += d[i];
+		return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+	}
+	/** Sum count ring elements starting at physical index start. */
+	float SumRing(unsigned int start, int count) const {
+		int first = Capacity - (int) start;
+		if (first >= count)
+			return SumBlock(_d + start, count);
+		return SumBlock(_d + start, first) + SumBlock(_d, count - first);
+	}
+	unsigned int Oldest() const {
+		return (_in - (unsigned int) _cnt) & kMask;
+	}
+public:
+	FixedMovingAverage() {
+		Clear();
+	}
+	float Process(float input) {
+		Push(input);
+		return _sum / (float) _cnt;
+	}
+	void Clear() {
+		_in = 0;
+		_cnt = 0;
+
+		_sum = 0;
+		_comp = 0;
+	}
+	void Push(float d) {
+		/* if full, pop one */
+		if (_cnt >= Capacity)
+			Pop();
+
+		Accumulate(d);
+		_d[_in] = d;
+		_in = (_in + 1) & kMask;
+		++_cnt;
+	}
+	/**
+	 * Push a block of samples, oldest first.  Equivalent to calling Push()
+	 * for each, but copies and sums in contiguous runs.
+	 */
+	void Push(const float *data, int count) {
+		if (count <= 0)
+			return;
+		if (count >= Capacity) {
+			/* Only the newest Capacity samples survive */
+			memcpy(_d, data + (count - Capacity), sizeof(_d));
+			_in = 0;
+			_cnt = Capacity;
+			Resum();
+			return;
+		}
+
+		int overflow = _cnt + count - Capacity;
+		if (overflow > 0) {
+			Accumulate(-SumRing(Oldest(), overflow));
+			_cnt -= overflow;
+		}
+
+		Accumulate(SumBlock(data, count));
+		int first = Capacity - (int) _in;
+		if (first >= count) {
+			memcpy(_d + _in, data, count * sizeof(float));
+		} else {
+			memcpy(_d + _in, data, first * sizeof(float));
+			memcpy(_d, data + first, (count - first) * sizeof(float));
+		}
+		_in = (_in + (unsigned int) count) & kMask;
+		_cnt += count;
+	}
+	void Pop() {
+		if (_cnt <= 0)
+			return;
+		/* get the oldest and remove it from the sum */
+		Accumulate(-_d[Oldest()]);
+		--_cnt;
+	}
+	/** Recompute the sum from the stored samples, dropping any accumulated error. */
+	void Resum() {
+		_sum = (_cnt > 0) ? SumRing(Oldest(), _cnt) : 0;
+		_comp = 0;
+	}
+	//-------------- Properties --------------//
+	float GetSum() const {
+		return _sum;
+	}
+	int GetCount() const {
+		return _cnt;
+	}
+	float GetAverage() const {
+		return (_cnt > 0) ? _sum / (float) _cnt : 0;
+	}
+	static int GetCapacity() {
+		return Capacity;
+	}
+};
+
+} // namespace  Signals
+} // namespace CTRE
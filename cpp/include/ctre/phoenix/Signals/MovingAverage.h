@@ -51,6 +51,11 @@ public:
 		_d = new float[_cap];
 		Clear();
 	}
+	~MovingAverage() {
+		delete[] _d;
+	}
+	MovingAverage(const MovingAverage &) = delete;
+	MovingAverage & operator=(const MovingAverage &) = delete;
 	float Process(float input) {
 		Push(input);
 		return _sum / (float) _cnt;
@@ -0,0 +1,71 @@
+#pragma once
+
+namespace CTRE {
+namespace Signals {
+
+/**
+ * Median of the last Window samples, good for rejecting single-sample spikes.
+ * Keeps the window both in arrival order and sorted, so each sample costs
+ * one insertion shift rather than a full sort.
+ * NaN samples are ignored, they have no place in the sorted order.
+ */
+template <int Window>
+class MovingMedian {
+	static_assert(Window > 0, "MovingMedian window must be positive");
+private:
+	float _ring[Window]; //!< samples in arrival order
+	float _sorted[Window]; //!< same samples, ascending
+	int _in;
+	int _cnt;
+public:
+	MovingMedian() {
+		Clear();
+	}
+	void Clear() {
+		_in = 0;
+		_cnt = 0;
+	}
+	float Process(float input) {
+		if (input != input) {
+			/* NaN, keep the window as it is */
+			return (_cnt > 0) ? Median() : input;
+		}
+		int pos;
+		if (_cnt >= Window) {
+			/* Remove the oldest from the sorted copy */
+			float old = _ring[_in];
+			pos = 0;
+			while (pos < _cnt - 1 && _sorted[pos] != old)
+				++pos;
+			for (; pos < _cnt - 1; ++pos)
+				_sorted[pos] = _sorted[pos + 1];
+			--_cnt;
+		}
+		_ring[_in] = input;
+		if (++_in >= Window)
+			_in = 0;
+
+		/* Insert the new sample in order */
+		pos = _cnt;
+		while (pos > 0 && _sorted[pos - 1] > input) {
+			_sorted[pos] = _sorted[pos - 1];
+			--pos;
+		}
+		_sorted[pos] = input;
+		++_cnt;
+
+		return Median();
+	}
+	int GetCount() const {
+		return _cnt;
+	}
+private:
+	float Median() const {
+		if (_cnt & 1)
+			return _sorted[_cnt / 2];
+		return 0.5f * (_sorted[_cnt / 2 - 1] + _sorted[_cnt / 2]);
+	}
+};
+
+} // namespace  Signals
+} // namespace CTRE
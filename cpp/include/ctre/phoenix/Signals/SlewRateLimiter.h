@@ -0,0 +1,76 @@
+#pragma once
+
+namespace CTRE {
+namespace Signals {
+
+/**
+ * Limits how far the output may move per Process() call.
+ * For a rate in units per second, pass rate times the loop period.
+ */
+class SlewRateLimiter {
+private:
+	float _maxRise;
+	float _maxFall;
+	float _y = 0;
+public:
+	SlewRateLimiter(float maxStep) {
+		_maxRise = maxStep;
+		_maxFall = maxStep;
+	}
+	/** Separate limits, e.g. ramp up slowly but allow stopping quickly. */
+	SlewRateLimiter(float maxRise, float maxFall) {
+		_maxRise = maxRise;
+		_maxFall = maxFall;
+	}
+	float Process(float input) {
+		float delta = input - _y;
+		if (delta > _maxRise)
+			delta = _maxRise;
+		else if (delta < -_maxFall)
+			delta = -_maxFall;
+		_y += delta;
+		return _y;
+	}
+	void Clear() {
+		_y = 0;
+	}
+	void Reset(float value) {
+		_y = value;
+	}
+};
+
+/**
+ * SlewRateLimiter on many channels with a shared limit.
+ */
+template <int Channels>
+class SlewRateLimiterBatch {
+private:
+	float _maxRise;
+	float _maxFall;
+	alignas(16) float _y[Channels];
+public:
+	SlewRateLimiterBatch(float maxRise, float maxFall) {
+		_maxRise = maxRise;
+		_maxFall = maxFall;
+		for (int i = 0; i < Channels; ++i)
+			_y[i] = 0;
+	}
+	void Reset(const float *value) {
+		for (int i = 0; i < Channels; ++i)
+			_y[i] = value[i];
+	}
+	void Process(const float * __restrict input, float * __restrict output) {
+		const float rise = _maxRise;
+		const float fall = -_maxFall;
+		for (int i = 0; i < Channels; ++i) {
+			float delta = input[i] - _y[i];
+			delta = (delta > rise) ? rise : delta;
+			delta = (delta < fall) ? fall : delta;
+			_y[i] += delta;
+			output[i] = _y[i];
+		}
+	}
+};
+
+} // namespace  Signals
+} // namespace CTRE
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "ctre/phoenix/Motion/Pose2d.h"
+#include <atomic>
+#include <type_traits>
+#include <sched.h>
+
+namespace CTRE {
+namespace Signals {
+
+/* Linear blend between two samples, overload for new sample types */
+inline float Interpolate(float a, float b, double frac) {
+	return (float)(a + (b - a) * frac);
+}
+inline double Interpolate(double a, double b, double frac) {
+	return a + (b - a) * frac;
+}
+inline int Interpolate(int a, int b, double frac) {
+	return a + (int)((b - a) * frac);
+}
+inline CTRE::Motion::Pose2d Interpolate(const CTRE::Motion::Pose2d & a, const CTRE::Motion::Pose2d & b, double frac) {
+	CTRE::Motion::Pose2d retval;
+	retval.x = a.x + (b.x - a.x) * frac;
+	retval.y = a.y + (b.y - a.y) * frac;
+	/* Blend heading the short way round */
+	retval.heading = CTRE::Motion::Pose2d::WrapDegrees(a.heading + CTRE::Motion::Pose2d::WrapDegrees(b.heading - a.heading) * frac);
+	return retval;
+}
+
+/**
+ * Fixed-capacity ring of timestamped samples with interpolated lookup.
+ * Storage is allocated once in the constructor, Push() overwrites the
+ * oldest sample once full.  Timestamps must be pushed in increasing order.
+ *
+ * One thread may Push() and Clear() while any number of others read.  The
+ * writer never blocks, it marks each change with a sequence counter and
+ * readers retry if a change overlapped their read.
+ */
+template <typename T>
+class TimeHistory {
+	/* Readers copy samples that Push() may be overwriting and only then
+	 * notice the retry, which is safe for plain data alone */
+	static_assert(std::is_trivially_copyable<T>::value, "TimeHistory needs a trivially copyable sample type");
+private:
+	struct Sample {
+		double t;
+		T value;
+	};
+
+	int _in; //!< head ptr for ringbuffer
+	int _ou; //!< tail ptr for ringbuffer
+	int _cnt; //!< number of element in ring buffer
+	int _cap; //!< capacity of ring buffer
+	Sample * _d; //!< ring buffer
+	std::atomic<unsigned int> _seq; //!< odd while the writer is changing the ring
+
+	/** Sample by age, 0 is the oldest of the cnt samples starting at ou */
+	const Sample & At(int ou, int i) const {
+		i += ou;
+		if (i >= _cap)
+			i -= _cap;
+		return _d[i];
+	}
+	void BeginWrite() {
+		_seq.store(_seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+	void EndWrite() {
+		_seq.store(_seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+	unsigned int BeginRead() const {
+		unsigned int seq;
+		int spins = 0;
+		while ((seq = _seq.load(std::memory_order_acquire)) & 1) {
+			/* Writer may be preempted on this core, let it finish */
+			if (++spins >= 16)
+				sched_yield();
+		}
+		return seq;
+	}
+	bool EndRead(unsigned int seq) const {
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return _seq.load(std::memory_order_relaxed) == seq;
+	}
+	bool Find(double timestamp, T & value) const {
+		int ou = _ou;
+		int cnt = _cnt;
+		if (cnt == 0)
+			return false;
+		if (timestamp < At(ou, 0).t || timestamp > At(ou, cnt - 1).t)
+			return false;
+
+		/* Find the first sample at or after the timestamp */
+		int lo = 0;
+		int hi = cnt - 1;
+		while (lo < hi) {
+			int mid = (lo + hi) / 2;
+			if (At(ou, mid).t < timestamp)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		const Sample & after = At(ou, lo);
+		if (lo == 0 || after.t == timestamp) {
+			value = after.value;
+			return true;
+		}
+		const Sample & before = At(ou, lo - 1);
+		double frac = (timestamp - before.t) / (after.t - before.t);
+		value = Interpolate(before.value, after.value, frac);
+		return true;
+	}
+public:
+	TimeHistory(int capacity) : _seq(0) {
+		_cap = (capacity > 0) ? capacity : 1;
+		_d = new Sample[_cap];
+		_in = 0;
+		_ou = 0;
+		_cnt = 0;
+	}
+	~TimeHistory() {
+		delete[] _d;
+	}
+	TimeHistory(const TimeHistory &) = delete;
+	TimeHistory & operator=(const TimeHistory &) = delete;
+
+	/** Writer thread only. */
+	void Clear() {
+		BeginWrite();
+		_in = 0;
+		_ou = 0;
+		_cnt = 0;
+		EndWrite();
+	}
+	/**
+	 * Writer thread only.
+	 * @return false if the timestamp is not newer than the latest sample.
+	 */
+	bool Push(double timestamp, const T & value) {
+		if (_cnt > 0 && timestamp <= At(_ou, _cnt - 1).t)
+			return false;
+		BeginWrite();
+		if (_cnt >= _cap) {
+			/* Full, drop the oldest */
+			_ou = (_ou + 1 >= _cap) ? 0 : _ou + 1;
+			--_cnt;
+		}
+		_d[_in].t = timestamp;
+		_d[_in].value = value;
+		_in = (_in + 1 >= _cap) ? 0 : _in + 1;
+		++_cnt;
+		EndWrite();
+		return true;
+	}
+	/**
+	 * Value at the requested time, interpolated between the two samples
+	 * bracketing it.
+	 * @return false if the time is outside the stored range.
+	 */
+	bool Get(double timestamp, T & value) const {
+		unsigned int seq;
+		bool found;
+		T result;
+		do {
+			seq = BeginRead();
+			found = Find(timestamp, result);
+		} while (EndRead(seq) == false);
+		if (found)
+			value = result;
+		return found;
+	}
+	bool GetLatest(double & timestamp, T & value) const {
+		unsigned int seq;
+		int cnt;
+		Sample s;
+		do {
+			seq = BeginRead();
+			cnt = _cnt;
+			if (cnt > 0)
+				s = At(_ou, cnt - 1);
+		} while (EndRead(seq) == false);
+		if (cnt == 0)
+			return false;
+		timestamp = s.t;
+		value = s.value;
+		return true;
+	}
+	double GetOldestTime() const {
+		unsigned int seq;
+		double t;
+		do {
+			seq = BeginRead();
+			t = (_cnt > 0) ? At(_ou, 0).t : 0;
+		} while (EndRead(seq) == false);
+		return t;
+	}
+	double GetNewestTime() const {
+		unsigned int seq;
+		double t;
+		do {
+			seq = BeginRead();
+			int cnt = _cnt;
+			t = (cnt > 0) ? At(_ou, cnt - 1).t : 0;
+		} while (EndRead(seq) == false);
+		return t;
+	}
+	int GetCount() const {
+		unsigned int seq;
+		int cnt;
+		do {
+			seq = BeginRead();
+			cnt = _cnt;
+		} while (EndRead(seq) == false);
+		return cnt;
+	}
+	int GetCapacity() const {
+		return _cap;
+	}
+};
+
+} // namespace  Signals
+} // namespace CTRE
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <time.h>
+#include <stdint.h>
 
 namespace CTRE {
 
@@ -9,11 +9,11 @@ public:
 	void Start();
 	unsigned int DurationMs();
 	float Duration();
-	
+	int64_t DurationNs();
+	float Lap();
+
 private:
-	unsigned long _t0 = 0;
-	unsigned long _t1 = 0;
-	float _scalar = 0.001f / CLOCKS_PER_SEC;
+	int64_t _t0 = 0;
 };
 
 }
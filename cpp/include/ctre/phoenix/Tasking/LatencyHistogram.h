@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+namespace CTRE {
+namespace Tasking {
+
+/**
+ * Log-linear histogram of durations in nanoseconds.
+ * Each power of two is split into 16 linear sub-buckets, so any recorded
+ * value is reported within ~6% of its true value from 1ns up to ~4s.
+ * Fixed size, Record() is a handful of integer ops and never allocates.
+ * Meant for one recording thread, other threads may read at any time.
+ */
+class LatencyHistogram {
+public:
+	static const int kSubBucketBits = 4;
+	static const int kSubBuckets = 1 << kSubBucketBits;
+	static const int kMaxMsb = 31;
+	static const int kBucketCount = kSubBuckets + (kMaxMsb - kSubBucketBits + 1) * kSubBuckets;
+
+	LatencyHistogram();
+	void Record(int64_t ns);
+	void Reset();
+
+	uint32_t GetCount() const;
+	int64_t GetMin() const;
+	int64_t GetMax() const;
+	int64_t GetMean() const;
+	int64_t GetPercentile(double percent) const;
+
+	static int BucketIndex(int64_t ns);
+	static int64_t BucketUpperBound(int index);
+
+private:
+	std::atomic<uint32_t> _counts[kBucketCount];
+	std::atomic<uint32_t> _total;
+	std::atomic<int64_t> _min;
+	std::atomic<int64_t> _max;
+	std::atomic<int64_t> _sum;
+};
+
+} // namespace Tasking
+} // namespace CTRE
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/LatencyHistogram.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+
+namespace CTRE {
+namespace Tasking {
+
+/**
+ * Execution time of one loopable's callbacks.
+ */
+struct LoopProfile {
+	ILoopable *loop;
+	LatencyHistogram onStart;
+	LatencyHistogram onLoop;
+	LatencyHistogram onStop;
+	std::atomic<uint32_t> overruns;	//!< OnLoop calls longer than the budget
+	std::atomic<int64_t> worstOverrunNs;
+	int originId;	//!< CTRLogger origin Dump() logs under
+};
+
+/**
+ * Collects per-loopable timing for the schedulers it is attached to.
+ * Attach with SetProfiler() on ConcurrentScheduler or SequentialScheduler.
+ * One profiler may be shared by several schedulers.
+ */
+class LoopProfiler {
+public:
+	enum Phase {
+		Start, Loop, Stop
+	};
+
+	LoopProfiler(int budgetUs = 20000, int dumpPeriodMs = 0);
+	~LoopProfiler();
+
+	LoopProfile * Register(ILoopable *aLoop);
+	LoopProfile * Get(ILoopable *aLoop);
+	int GetCount();
+	LoopProfile * GetAt(int idx);
+
+	void SetBudget(int budgetUs);
+	void SetDumpPeriod(int dumpPeriodMs);
+	void Reset();
+	void Dump();
+
+	/** CLOCK_MONOTONIC timestamp to pass to Record(), not Timebase time. */
+	static int64_t Begin();
+	void Record(LoopProfile *profile, Phase phase, int64_t startNs);
+	void Poll();
+
+private:
+	std::vector<LoopProfile*> _profiles;
+	std::mutex _lock;
+	std::atomic<int64_t> _budgetNs;
+	std::atomic<int64_t> _dumpPeriodNs;
+	std::atomic<int64_t> _nextDumpNs;
+};
+
+} // namespace Tasking
+} // namespace CTRE
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ctre/phoenix/Stopwatch.h"
+#include "ctre/phoenix/Tasking/ILoopable.h"
+
+namespace CTRE {
+namespace Tasking {
+
+/**
+ * Base for loopables written as straight-line code instead of a _state switch.
+ *
+ * Override Run() and bracket the body with CTR_ROUTINE_BEGIN / CTR_ROUTINE_END.
+ * Each OnLoop() resumes Run() where it last waited, e.g.
+ *
+ *	void Run() {
+ *		CTR_ROUTINE_BEGIN();
+ *		CTR_ROUTINE_RUN(_driveToBar);
+ *		CTR_ROUTINE_WAIT_MS(250);
+ *		CTR_ROUTINE_AWAIT(_arm->GetSelectedSensorPosition() > 4000);
+ *		CTR_ROUTINE_END();
+ *	}
+ *
+ * The resume point is a single int in the object, so there is no frame to
+ * allocate.  Local variables do not survive a wait, keep state in members.
+ * Waits must not be placed inside a nested switch statement, and only one
+ * wait may appear per source line.
+ */
+class Routine : public ILoopable {
+public:
+	virtual ~Routine() { }
+
+	/* ILoopable */
+	void OnStart();
+	void OnLoop();
+	bool IsDone();
+	void OnStop();
+
+protected:
+	/** Routine body, see class description. */
+	virtual void Run() = 0;
+
+	int _resumeLine = 0;
+	bool _isDone = false;
+	ILoopable *_child = nullptr;
+	CTRE::Stopwatch _waitTimer;
+
+	void BeginWait();
+	unsigned int WaitedMs();
+};
+
+} // namespace Tasking
+} // namespace CTRE
+
+#define CTR_ROUTINE_BEGIN() switch (_resumeLine) { case 0:
+
+/** Give up the rest of this loop, continue on the next one. */
+#define CTR_ROUTINE_YIELD() \
+	do { _resumeLine = __LINE__; return; case __LINE__:; } while (0)
+
+/** Resume each loop until cond is true. */
+#define CTR_ROUTINE_AWAIT(cond) \
+	do { _resumeLine = __LINE__; if (0) { case __LINE__:; } if (!(cond)) return; } while (0)
+
+/** Wait at least ms milliseconds. */
+#define CTR_ROUTINE_WAIT_MS(ms) \
+	do { BeginWait(); _resumeLine = __LINE__; if (0) { case __LINE__:; } if (WaitedMs() < (unsigned int)(ms)) return; } while (0)
+
+/** Start another loopable and loop it until it reports done. */
+#define CTR_ROUTINE_RUN(loopable) \
+	do { _child = &(loopable); _child->OnStart(); _resumeLine = __LINE__; if (0) { case __LINE__:; } \
+		_child->OnLoop(); if (_child->IsDone() == false) return; _child = nullptr; } while (0)
+
+#define CTR_ROUTINE_END() } _isDone = true; _resumeLine = -1
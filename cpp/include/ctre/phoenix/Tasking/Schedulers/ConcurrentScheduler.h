@@ -3,22 +3,36 @@
 #include <vector>
 #include "ctre/phoenix/Tasking/ILoopable.h"
 #include "ctre/phoenix/Tasking/IProcessable.h"
+#include "ctre/phoenix/Tasking/ThreadPool.h"
+#include "ctre/phoenix/Tasking/LoopProfiler.h"
+#include "ctre/phoenix/DeviceCache.h"
 
 namespace CTRE { namespace Tasking { namespace Schedulers {
 
 class ConcurrentScheduler: public ILoopable, public IProcessable{
 public:
-	std::vector<ILoopable*> _loops;
-	std::vector<bool> _enabs;
+	/** Returned by Add(), stays valid until RemoveAll(). */
+	typedef int Handle;
 
 	ConcurrentScheduler();
 	virtual ~ConcurrentScheduler();
-	void Add(ILoopable *aLoop, bool enable = true);
+	Handle Add(ILoopable *aLoop, bool enable = true);
 	void RemoveAll();
+	void Start(Handle toStart);
+	void Stop(Handle toStop);
 	void Start(ILoopable *toStart);
 	void Stop(ILoopable *toStop);
 	void StartAll();
 	void StopAll();
+	bool IsEnabled(Handle handle);
+	Handle Find(ILoopable *aLoop);
+	int GetCount();
+	int GetActiveCount();
+	void SetThreadPool(ThreadPool *pool);
+	void SetAffinity(Handle handle, int group);
+	void SetAffinity(ILoopable *aLoop, int group);
+	void SetProfiler(LoopProfiler *profiler);
+	void SetDeviceCache(CTRE::DeviceCache *cache);
 
 	//IProcessable
 	void Process();
@@ -29,5 +43,41 @@ public:
 	void OnLoop();
 	void OnStop();
 	bool IsDone();
+
+private:
+	struct Entry {
+		ILoopable *loop;
+		bool enabled;
+		int activeSlot;	//!< index in _active, -1 if not listed; may lag enabled during a tick
+		int affinity;
+		LoopProfile *profile;
+	};
+	/* loopables that must run on the same thread, one after another */
+	struct ParallelGroup {
+		ConcurrentScheduler *owner;
+		int affinity;
+		std::vector<Handle> loops;
+	};
+	std::vector<Entry> _entries;
+	/* handles of enabled entries, unordered, dense so each tick touches only active loopables */
+	std::vector<Handle> _active;
+	int _activeCount = 0;
+	bool _iterating = false;
+	bool _dirty = false;
+	ThreadPool *_pool = nullptr;
+	LoopProfiler *_profiler = nullptr;
+	CTRE::DeviceCache *_deviceCache = nullptr;
+	std::vector<ParallelGroup> _groups;
+	int _groupCount = 0;
+
+	void Activate(Handle handle);
+	void Deactivate(Handle handle);
+	void Unlist(Handle handle);
+	void Compact();
+	void CallStart(Handle handle);
+	void CallLoop(Handle handle);
+	void CallStop(Handle handle);
+	void ProcessParallel();
+	static void RunGroup(void *group);
 };
 }}}
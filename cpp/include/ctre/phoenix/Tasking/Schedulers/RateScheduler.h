@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <stdint.h>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+#include "ctre/phoenix/DeviceCache.h"
+
+namespace CTRE { namespace Tasking { namespace Schedulers {
+
+/**
+ * Runs each loopable at its own period against absolute deadlines.
+ * When several loopables are due at once, higher priority runs first.
+ * Drive it from its own thread with StartThread(), or call Process()
+ * periodically to run whatever is due.  Start/Stop and the stats may be
+ * used from any thread, they wait for a pass in progress to finish.
+ */
+class RateScheduler: public ILoopable, public IProcessable{
+public:
+	struct Stats {
+		unsigned int runs;			//!< OnLoop calls
+		unsigned int missed;		//!< whole periods skipped because we ran late
+		int64_t lastJitterNs;		//!< start time minus deadline, last run
+		int64_t maxJitterNs;
+		int64_t sumJitterNs;
+	};
+
+	RateScheduler();
+	virtual ~RateScheduler();
+	void Add(ILoopable *aLoop, int periodUs, int priority = 0, bool enable = true);
+	void RemoveAll();
+	void Start(ILoopable *toStart);
+	void Stop(ILoopable *toStop);
+	void StartAll();
+	void StopAll();
+	bool GetStats(ILoopable *aLoop, Stats & stats);
+	void ResetStats();
+	void SetDeviceCache(CTRE::DeviceCache *cache);
+
+	bool StartThread();
+	void StopThread();
+
+	//IProcessable
+	void Process();
+
+	//ILoopable
+	void OnStart();
+	void OnLoop();
+	void OnStop();
+	bool IsDone();
+
+private:
+	struct Entry {
+		ILoopable *loop;
+		int64_t periodNs;
+		int priority;
+		bool enabled;
+		int64_t deadlineNs;
+		Stats stats;
+	};
+	/* sorted by priority, highest first */
+	std::vector<Entry> _entries;
+	CTRE::DeviceCache *_deviceCache = nullptr;
+	/* guards enabled, deadlines and stats against the pass */
+	std::recursive_mutex _lock;
+	std::atomic<bool> _threadRunning;
+	std::thread _thread;
+
+	int64_t RunDue(int64_t nowNs);
+	void ThreadLoop();
+};
+}}}
@@ -3,6 +3,8 @@
 #include <vector>
 #include "ctre/phoenix/Tasking/ILoopable.h"
 #include "ctre/phoenix/Tasking/IProcessable.h"
+#include "ctre/phoenix/Tasking/LoopProfiler.h"
+#include "ctre/phoenix/DeviceCache.h"
 
 namespace CTRE { namespace Tasking { namespace Schedulers {
 
@@ -10,6 +12,7 @@ class SequentialScheduler: public ILoopable, public IProcessable{
 public:
 	bool _running = false;
 	std::vector<ILoopable*> _loops;
+	std::vector<LoopProfile*> _profiles;
 	unsigned int _idx = 0;
 	bool _iterated = false;
 
@@ -21,6 +24,8 @@ public:
 	void RemoveAll();
 	void Start();
 	void Stop();
+	void SetProfiler(LoopProfiler *profiler);
+	void SetDeviceCache(CTRE::DeviceCache *cache);
 
 	//IProcessable
 	void Process();
@@ -30,5 +35,13 @@ public:
 	void OnLoop();
 	void OnStop();
 	bool IsDone();
+
+private:
+	LoopProfiler *_profiler = nullptr;
+	CTRE::DeviceCache *_deviceCache = nullptr;
+
+	void CallStart(unsigned int idx);
+	void CallLoop(unsigned int idx);
+	void CallStop(unsigned int idx);
 };
 }}}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+
+namespace CTRE { namespace Tasking { namespace Schedulers {
+
+/**
+ * ConcurrentScheduler for a set of loopables fixed at compile time.
+ *
+ *	StaticScheduler<DriveLoop, ArmLoop, LedLoop> sched(drive, arm, leds);
+ *
+ * Each loopable is called through its concrete type with a qualified call,
+ * so the per-tick pass has no virtual dispatch and can be fully inlined.
+ * The scheduler itself is still an ILoopable so it can be nested in others.
+ * Loopables are referenced, not copied, and must outlive the scheduler.
+ */
+template <typename... Loops>
+class StaticScheduler: public ILoopable, public IProcessable{
+public:
+	static const int kCount = sizeof...(Loops);
+
+	StaticScheduler(Loops &... loops) :
+			_loops(loops...) {
+		for (int i = 0; i < kCount; ++i)
+			_enabs[i] = true;
+	}
+	virtual ~StaticScheduler() {
+	}
+
+	template <int I>
+	void Start() {
+		_enabs[I] = true;
+		auto & loop = std::get<I>(_loops);
+		CallStart(loop);
+	}
+	template <int I>
+	void Stop() {
+		_enabs[I] = false;
+		auto & loop = std::get<I>(_loops);
+		CallStop(loop);
+	}
+	template <int I>
+	bool IsEnabled() const {
+		return _enabs[I];
+	}
+	void StartAll() {
+		StartAll(std::make_index_sequence<kCount>());
+	}
+	void StopAll() {
+		StopAll(std::make_index_sequence<kCount>());
+	}
+	/** True once every loopable reports IsDone. */
+	bool AllDone() {
+		return AllDone(std::make_index_sequence<kCount>());
+	}
+
+	//IProcessable
+	void Process() {
+		Process(std::make_index_sequence<kCount>());
+	}
+
+	//ILoopable
+	void OnStart() {
+		StartAll();
+	}
+	void OnLoop() {
+		Process();
+	}
+	void OnStop() {
+		StopAll();
+	}
+	bool IsDone() {
+		return false;
+	}
+
+private:
+	std::tuple<Loops&...> _loops;
+	bool _enabs[kCount > 0 ? kCount : 1];
+
+	/* Qualified calls bind statically to the concrete type's override */
+	template <typename T>
+	static void CallStart(T & loop) {
+		loop.T::OnStart();
+	}
+	template <typename T>
+	static void CallLoop(T & loop) {
+		loop.T::OnLoop();
+	}
+	template <typename T>
+	static void CallStop(T & loop) {
+		loop.T::OnStop();
+	}
+	template <typename T>
+	static bool CallIsDone(T & loop) {
+		return loop.T::IsDone();
+	}
+
+	/* Pack expansion in a braced list keeps left to right order without fold expressions */
+	template <std::size_t... I>
+	void StartAll(std::index_sequence<I...>) {
+		int expand[] = { 0, (_enabs[I] = true, CallStart(std::get<I>(_loops)), 0)... };
+		(void) expand;
+	}
+	template <std::size_t... I>
+	void StopAll(std::index_sequence<I...>) {
+		int expand[] = { 0, (_enabs[I] = false, CallStop(std::get<I>(_loops)), 0)... };
+		(void) expand;
+	}
+	template <std::size_t... I>
+	void Process(std::index_sequence<I...>) {
+		int expand[] = { 0, (_enabs[I] ? CallLoop(std::get<I>(_loops)) : (void) 0, 0)... };
+		(void) expand;
+	}
+	template <std::size_t... I>
+	bool AllDone(std::index_sequence<I...>) {
+		bool done = true;
+		int expand[] = { 0, (done = done && CallIsDone(std::get<I>(_loops)), 0)... };
+		(void) expand;
+		return done;
+	}
+};
+}}}
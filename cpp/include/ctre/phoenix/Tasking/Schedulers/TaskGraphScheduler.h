@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <initializer_list>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+#include "ctre/phoenix/Tasking/ThreadPool.h"
+
+namespace CTRE { namespace Tasking { namespace Schedulers {
+
+/**
+ * Runs loopables as nodes of a dependency graph.
+ * A node starts once every node it depends on is done, so
+ * "drive path while raising elevator, then score" is three nodes with
+ * the score node depending on the other two.
+ *
+ * A node is either a single loopable or a group of them:
+ *  Parallel - done when every member is done.
+ *  Race     - done when any member is done, the rest are stopped.
+ *  Deadline - done when the first member is done, the rest are stopped.
+ *
+ * With a thread pool set, running nodes are looped on worker threads.
+ * Members of one node always run on the same thread.
+ */
+class TaskGraphScheduler: public ILoopable, public IProcessable{
+public:
+	typedef int Node;
+
+	TaskGraphScheduler();
+	virtual ~TaskGraphScheduler();
+
+	Node Add(ILoopable *aLoop);
+	Node AddParallel(std::initializer_list<ILoopable*> loops);
+	Node AddRace(std::initializer_list<ILoopable*> loops);
+	Node AddDeadline(ILoopable *deadline, std::initializer_list<ILoopable*> others);
+	bool AddDependency(Node node, Node dependsOn);
+	void RemoveAll();
+	void SetThreadPool(ThreadPool *pool);
+
+	void Start();
+	void Stop();
+	bool IsNodeDone(Node node);
+	int GetRunningCount();
+
+	//IProcessable
+	void Process();
+
+	//ILoopable
+	void OnStart();
+	void OnLoop();
+	void OnStop();
+	bool IsDone();
+
+private:
+	enum Kind {
+		Single, Parallel, Race, Deadline
+	};
+	enum State {
+		Waiting, Running, Finished
+	};
+	struct NodeData {
+		Kind kind;
+		State state;
+		std::vector<ILoopable*> loops;
+		std::vector<char> loopDone;
+		std::vector<Node> successors;
+		int dependencyCount;
+		int remaining;	//!< dependencies not yet done this run
+	};
+
+	std::vector<NodeData> _nodes;
+	/* nodes currently running, dense */
+	std::vector<Node> _running;
+	/* nodes that finished this tick, kept to avoid per-tick allocation */
+	std::vector<Node> _finished;
+	ThreadPool *_pool = nullptr;
+	bool _started = false;
+
+	Node AddNode(Kind kind, std::initializer_list<ILoopable*> loops);
+	void StartNode(Node node);
+	bool NodeComplete(NodeData & nd);
+	static void RunNode(void *node);
+};
+}}}
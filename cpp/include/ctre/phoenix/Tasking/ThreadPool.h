@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CTRE {
+namespace Tasking {
+
+/**
+ * Fixed set of worker threads, each with its own task queue.
+ * Idle workers steal from the front of other queues, owners pop from the back.
+ * Tasks are a function pointer and an argument so submitting never allocates
+ * once the queues have grown to their working size.
+ */
+class ThreadPool {
+public:
+	typedef void (*TaskFunc)(void *arg);
+
+	ThreadPool(int workerCount);
+	~ThreadPool();
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool & operator=(const ThreadPool &) = delete;
+
+	void Submit(TaskFunc func, void *arg, int worker = -1);
+	void Wait();
+	int GetWorkerCount();
+
+private:
+	struct Task {
+		TaskFunc func;
+		void *arg;
+	};
+	struct Worker {
+		std::deque<Task> queue;
+		std::mutex lock;
+		std::thread thread;
+	};
+
+	std::vector<Worker*> _workers;
+	std::atomic<int> _queued;	//!< tasks sitting in a queue
+	std::atomic<int> _pending;	//!< tasks submitted but not finished
+	std::atomic<unsigned int> _nextWorker;
+	std::mutex _sleepLock;
+	std::condition_variable _workCv;
+	std::condition_variable _doneCv;
+	bool _stop = false;
+
+	bool PopOwn(int idx, Task & task);
+	bool Steal(int thief, Task & task);
+	void RunTask(const Task & task);
+	void WorkerLoop(int idx);
+};
+
+} // namespace Tasking
+} // namespace CTRE
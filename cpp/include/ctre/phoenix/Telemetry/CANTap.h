@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+namespace CTRE { namespace Telemetry {
+
+/**
+ * Mirrors the CAN frames the driver sends and receives into a capture file.
+ *
+ * The driver is prebuilt, so frames are tapped where it calls into the NI CAN
+ * layer.  Link the robot program with
+ *
+ *   -Wl,--wrap=FRC_NetworkCommunication_CANSessionMux_sendMessage
+ *   -Wl,--wrap=FRC_NetworkCommunication_CANSessionMux_receiveMessage
+ *   -Wl,--wrap=FRC_NetworkCommunication_CANSessionMux_readStreamSession
+ *
+ * to route those calls through the tap.  Without the flags nothing is tapped
+ * and IsLinked() returns false.  Code that talks to the bus on its own may
+ * call Record() directly.
+ *
+ * While no capture is running a tapped call costs one extra branch.  While
+ * running, frames are copied into a fixed lock-free ring and a background
+ * thread writes them out, either as candump log lines (can-utils, canplayer)
+ * or as pcap with the SocketCAN link type (Wireshark, tcpdump).  Frames that
+ * find the ring full are dropped and counted.  Timestamps come from Timebase.
+ *
+ * Periodic frames are handed to the NI layer once and repeated there, so they
+ * show up each time they are scheduled rather than at every period.
+ */
+class CANTap {
+public:
+	enum Format {
+		CandumpFormat,	//!< "(sec.usec) can0 ID#DATA" lines
+		PcapFormat,		//!< pcap, LINKTYPE_CAN_SOCKETCAN (227), nanosecond timestamps
+	};
+	struct Stats {
+		uint64_t txFrames;		//!< frames sent while capturing
+		uint64_t rxFrames;		//!< frames received while capturing
+		uint64_t droppedFrames;	//!< frames lost because the ring was full
+		uint64_t writtenFrames;	//!< frames written to the file
+	};
+
+	static bool Start(const std::string & path, Format format, const char *interfaceName = "can0");
+	static void Stop();
+	static bool IsRunning();
+	static bool IsLinked();
+	static void Record(uint32_t messageId, const uint8_t *data, uint8_t length, bool transmit);
+	static void GetStats(Stats & stats);
+	static void ResetStats();
+
+private:
+	static void WriterLoop();
+};
+
+}}
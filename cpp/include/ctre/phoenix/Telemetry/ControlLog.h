@@ -0,0 +1,33 @@
+#pragma once
+
+#include <mutex>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+namespace CTRE { namespace Telemetry {
+
+/**
+ * Text log of every demand sent to a motor controller, one line per Set():
+ *
+ *	timestamp_ns arbitration_id mode demand0 demand1
+ *
+ * with the raw values handed to the driver.  Record one during a match and
+ * another while replaying it, then compare them with diff.  Attach with
+ * BaseMotorController::SetControlLog().
+ */
+class ControlLog {
+public:
+	~ControlLog();
+	bool Open(const std::string & path, bool timestamps = true);
+	void Close();
+	void Record(int arbId, int mode, int demand0, int demand1);
+	uint32_t GetCount();
+private:
+	FILE *_file = nullptr;
+	bool _timestamps = true;
+	uint32_t _count = 0;
+	std::mutex _lock;
+};
+
+}}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+namespace CTRE { namespace Telemetry {
+
+/**
+ * File layout and column codecs for recorded telemetry, shared by the
+ * recorder and the reader.  All fields are little endian.
+ *
+ *	TelemetryFileHeader
+ *	TelemetrySignalDesc[signalCount]
+ *	blocks, each:
+ *		TelemetryBlockHeader
+ *		uint32_t columnBytes[signalCount]
+ *		time column, timeBytes long
+ *		signal columns in signal order, columnBytes[i] long
+ *
+ * Every block restarts its codecs from zero, so any block (and any one
+ * column within it) decodes on its own.
+ *
+ * Time column:		zigzag varint of delta-of-delta nanoseconds.
+ * Integer columns:	zigzag varint of the delta from the previous row.
+ * Float columns:	bits XOR previous bits.  One byte of 0 when equal, else one byte of
+ *					(trailing zero count + 1) followed by a varint of the XOR shifted down.
+ */
+static const char kTelemetryMagic[8] = {'C', 'T', 'R', 'T', 'L', 'M', '0', '1'};
+static const uint32_t kTelemetryVersion = 1;
+static const uint32_t kTelemetryBlockMagic = 0x314B4C42; /* "BLK1" */
+
+enum TelemetryDeviceType {
+	MotorControllerDevice = 1,
+	PigeonDevice = 2,
+	CANifierDevice = 3,
+};
+
+enum TelemetrySignalKind {
+	IntegerSignal = 0,
+	FloatSignal = 1,
+};
+
+struct TelemetryFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t signalCount;
+};
+
+struct TelemetrySignalDesc {
+	uint32_t deviceType;	//!< TelemetryDeviceType
+	int32_t deviceId;		//!< arbitration id for motor controllers, device number otherwise
+	uint32_t kind;			//!< TelemetrySignalKind
+	char name[20];			//!< zero padded
+};
+
+struct TelemetryBlockHeader {
+	uint32_t magic;
+	uint32_t rowCount;
+	int64_t firstTimestampNs;
+	int64_t lastTimestampNs;
+	uint32_t timeBytes;
+	uint32_t signalCount;
+};
+
+static_assert(sizeof(TelemetryFileHeader) == 16, "file header layout");
+static_assert(sizeof(TelemetrySignalDesc) == 32, "signal layout");
+static_assert(sizeof(TelemetryBlockHeader) == 32, "block header layout");
+
+/* Worst case encoded bytes per row */
+static const int kMaxTimeBytes = 10;
+static const int kMaxIntegerBytes = 5;
+static const int kMaxFloatBytes = 6;
+
+inline uint64_t ZigZag(int64_t v) {
+	return ((uint64_t) v << 1) ^ (uint64_t) (v >> 63);
+}
+inline int64_t UnZigZag(uint64_t v) {
+	return (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+}
+inline int PutVarint(uint8_t *out, uint64_t v) {
+	int n = 0;
+	while (v >= 0x80) {
+		out[n++] = (uint8_t) (v | 0x80);
+		v >>= 7;
+	}
+	out[n++] = (uint8_t) v;
+	return n;
+}
+/** @return position after the varint, nullptr if it runs past end. */
+inline const uint8_t * GetVarint(const uint8_t *in, const uint8_t *end, uint64_t & v) {
+	v = 0;
+	for (int shift = 0; in < end && shift < 64; shift += 7) {
+		uint8_t b = *in++;
+		v |= (uint64_t) (b & 0x7F) << shift;
+		if ((b & 0x80) == 0)
+			return in;
+	}
+	return nullptr;
+}
+
+/** Delta-of-delta timestamp codec state. */
+struct TimeCodec {
+	int64_t previous = 0;
+	int64_t previousDelta = 0;
+
+	int Encode(uint8_t *out, int64_t t) {
+		int64_t delta = t - previous;
+		int n = PutVarint(out, ZigZag(delta - previousDelta));
+		previous = t;
+		previousDelta = delta;
+		return n;
+	}
+	const uint8_t * Decode(const uint8_t *in, const uint8_t *end, int64_t & t) {
+		uint64_t raw;
+		in = GetVarint(in, end, raw);
+		if (in == nullptr)
+			return nullptr;
+		previousDelta += UnZigZag(raw);
+		previous += previousDelta;
+		t = previous;
+		return in;
+	}
+};
+
+/** Delta codec for integer signals. */
+struct IntegerCodec {
+	int32_t previous = 0;
+
+	int Encode(uint8_t *out, int32_t v) {
+		int n = PutVarint(out, ZigZag((int64_t) v - previous));
+		previous = v;
+		return n;
+	}
+	const uint8_t * Decode(const uint8_t *in, const uint8_t *end, int32_t & v) {
+		uint64_t raw;
+		in = GetVarint(in, end, raw);
+		if (in == nullptr)
+			return nullptr;
+		previous = (int32_t) (previous + UnZigZag(raw));
+		v = previous;
+		return in;
+	}
+};
+
+/** XOR codec for float signals, slowly changing values mostly cost one or two bytes. */
+struct FloatCodec {
+	uint32_t previous = 0;
+
+	int Encode(uint8_t *out, float v) {
+		uint32_t bits;
+		memcpy(&bits, &v, sizeof(bits));
+		uint32_t x = bits ^ previous;
+		previous = bits;
+		if (x == 0) {
+			out[0] = 0;
+			return 1;
+		}
+		int tz = __builtin_ctz(x);
+		out[0] = (uint8_t) (tz + 1);
+		return 1 + PutVarint(out + 1, x >> tz);
+	}
+	const uint8_t * Decode(const uint8_t *in, const uint8_t *end, float & v) {
+		if (in >= end)
+			return nullptr;
+		int tz = *in++;
+		if (tz > 0) {
+			uint64_t raw;
+			in = GetVarint(in, end, raw);
+			if (in == nullptr || tz > 32)
+				return nullptr;
+			previous ^= (uint32_t) raw << (tz - 1);
+		}
+		memcpy(&v, &previous, sizeof(v));
+		return in;
+	}
+};
+
+}}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "TelemetryFormat.h"
+#include <string>
+#include <vector>
+
+namespace CTRE { namespace Telemetry {
+
+/**
+ * Queries a file written by TelemetryRecorder without decoding all of it.
+ *
+ * Open() reads only the block headers to build a time index.  A query
+ * picks the blocks overlapping its time range and decodes just the time
+ * column and the one requested column of each, spread across threads.
+ */
+class TelemetryReader {
+public:
+	struct Sample {
+		int64_t timestampNs;
+		double value;
+	};
+
+	TelemetryReader();
+	~TelemetryReader();
+
+	bool Open(const std::string & path);
+	void Close();
+
+	int GetSignalCount();
+	const TelemetrySignalDesc & GetSignal(int index);
+	int FindSignal(TelemetryDeviceType type, int deviceNumber, const char *name);
+
+	int GetBlockCount();
+	int64_t GetStartNs();
+	int64_t GetEndNs();
+
+	bool Query(int signal, int64_t startNs, int64_t endNs, std::vector<Sample> & samples, int threads = 0);
+	bool QueryChanges(int signal, int64_t startNs, int64_t endNs, std::vector<Sample> & samples, int threads = 0);
+
+private:
+	struct BlockIndex {
+		int64_t firstTimestampNs;
+		int64_t lastTimestampNs;
+		uint32_t rows;
+		int64_t timeOffset;		//!< file offset of the time column
+		uint32_t timeBytes;
+		std::vector<int64_t> columnOffsets;
+		std::vector<uint32_t> columnBytes;
+	};
+	int _fd = -1;
+	std::vector<TelemetrySignalDesc> _signals;
+	std::vector<BlockIndex> _blocks;
+
+	bool DecodeBlock(const BlockIndex & block, int signal, int64_t startNs, int64_t endNs, std::vector<Sample> & samples);
+};
+
+}}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "ctre/phoenix/CANifier.h"
+#include "ctre/phoenix/MotorControl/IMotorController.h"
+#include "ctre/phoenix/Sensors/PigeonIMU.h"
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "TelemetryFormat.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace CTRE { namespace Telemetry {
+
+/**
+ * Records every status signal of the added devices into compressed columns.
+ *
+ * Each Sample() reads all signals once and appends one row.  Rows collect
+ * into fixed size blocks, one compressed column per signal, and full blocks
+ * are written out by a background thread so the sampling side never touches
+ * the file.  When the writer falls behind, whole blocks are dropped and counted
+ * rather than blocking the caller.
+ *
+ * Add devices before Start(), Add() refuses them while recording.  Sample() may be driven by a scheduler (ILoopable)
+ * or by the built-in thread (StartThread), but only one of them at a time.
+ */
+class TelemetryRecorder : public CTRE::Tasking::ILoopable {
+public:
+	struct Stats {
+		uint64_t rows;			//!< rows recorded
+		uint64_t droppedRows;	//!< rows lost because no block was free
+		uint64_t blocks;		//!< blocks written
+		uint64_t bytes;			//!< bytes written, headers included
+	};
+
+	TelemetryRecorder(int rowsPerBlock = 256, int blockCount = 8);
+	virtual ~TelemetryRecorder();
+
+	bool Add(CTRE::MotorControl::IMotorController *motorController);
+	bool Add(CTRE::PigeonIMU *pigeon);
+	bool Add(CTRE::CANifier *canifier);
+	int GetSignalCount();
+	const TelemetrySignalDesc & GetSignal(int index);
+
+	bool Start(const std::string & path);
+	void Stop();
+	void Sample();
+	void GetStats(Stats & stats);
+
+	bool StartThread(int periodUs = 10000);
+	void StopThread();
+
+	/* ILoopable */
+	void OnStart();
+	void OnLoop();
+	bool IsDone();
+	void OnStop();
+
+private:
+	struct Device {
+		TelemetryDeviceType type;
+		void *device;
+	};
+	struct Column {
+		std::vector<uint8_t> bytes;
+		uint32_t used;
+	};
+	struct Block {
+		uint32_t rows;
+		int64_t firstTimestampNs;
+		int64_t lastTimestampNs;
+		Column time;
+		std::vector<Column> columns;
+	};
+	union Value {
+		int32_t i;
+		float f;
+	};
+
+	std::vector<Device> _devices;
+	std::vector<TelemetrySignalDesc> _signals;
+	int _rowsPerBlock;
+	int _blockCount;
+
+	/* sampling side */
+	std::vector<Value> _row;
+	Block *_current = nullptr;
+	TimeCodec _timeCodec;
+	std::vector<IntegerCodec> _intCodecs;
+	std::vector<FloatCodec> _floatCodecs;
+
+	/* hand-off to the writer */
+	std::vector<Block*> _blocks;
+	std::deque<Block*> _free;
+	std::deque<Block*> _full;
+	std::mutex _lock;
+	std::condition_variable _fullReady;
+	std::thread _writer;
+	bool _writing = false;
+	FILE *_file = nullptr;
+
+	std::atomic<uint64_t> _rows;
+	std::atomic<uint64_t> _droppedRows;
+	std::atomic<uint64_t> _blocksWritten;
+	std::atomic<uint64_t> _bytes;
+
+	std::atomic<bool> _threadRunning;
+	std::thread _thread;
+
+	void AddSignal(TelemetryDeviceType type, int32_t deviceId, TelemetrySignalKind kind, const char *name);
+	void ReadRow();
+	void BeginBlock();
+	void SealBlock();
+	void WriterLoop();
+	void WriteBlock(Block *block);
+	void ThreadLoop(int periodUs);
+};
+
+}}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ctre/phoenix/DeviceCache.h"
+#include "ctre/phoenix/Timebase.h"
+#include "TelemetryReader.h"
+#include <vector>
+
+namespace CTRE { namespace Telemetry {
+
+/**
+ * Plays a recording made by TelemetryRecorder back into a DeviceCache.
+ *
+ * Every loopable that reads through the cache then sees the recorded match
+ * instead of live devices.  With a ManualClock the replay runs as fast as
+ * possible and Timebase reports the recorded timestamps, so a ControlLog
+ * taken during replay can be diffed against one taken during the match.
+ * Without one, Step() sleeps to reproduce the recorded timing.
+ *
+ * Load() stops motor controller demands from being transmitted, they are
+ * only copied into the ControlLog.  Still, never replay on a robot with live
+ * actuators: configuration calls and anything not going through Set() are
+ * still sent.
+ *
+ *	replay.Load(reader);
+ *	while (replay.Step())
+ *		scheduler.Process();
+ */
+class TelemetryReplay {
+public:
+	TelemetryReplay(CTRE::DeviceCache *cache, CTRE::ManualClock *clock = nullptr);
+
+	bool Load(TelemetryReader & reader, int threads = 0);
+	bool Step();
+	void Rewind();
+
+	int GetRowCount();
+	int GetRowIndex();
+	int GetBoundSignalCount();
+
+private:
+	enum Target {
+		PigeonYaw, PigeonPitch, PigeonRoll, PigeonGyroX, PigeonGyroY, PigeonGyroZ, PigeonState,
+		MotorPosition, MotorVelocity, MotorCurrent, MotorBusVoltage, MotorOutputPercent, MotorTemperature,
+	};
+	struct Binding {
+		Target target;
+		CTRE::DeviceCache::Handle handle;
+		std::vector<double> values;
+	};
+	CTRE::DeviceCache *_cache;
+	CTRE::ManualClock *_clock;
+	std::vector<int64_t> _times;
+	std::vector<Binding> _bindings;
+	int _row = 0;
+	int64_t _wallStartNs = 0;
+
+	bool Bind(const TelemetrySignalDesc & signal, Binding & binding);
+	void Apply(const Binding & binding, double value);
+};
+
+}}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+namespace CTRE {
+
+/**
+ * Source of time for everything that reads Timebase.
+ * Swap in a different source to run loops against simulated time.
+ */
+class IClockSource {
+public:
+	virtual ~IClockSource(){}
+	/** Nanoseconds since an arbitrary fixed point, never goes backwards. */
+	virtual int64_t NowNs() = 0;
+	/** Block until NowNs() reaches ns. */
+	virtual void SleepUntilNs(int64_t ns) = 0;
+};
+
+/**
+ * CLOCK_MONOTONIC, the default source.
+ */
+class MonotonicClock : public IClockSource {
+public:
+	int64_t NowNs();
+	void SleepUntilNs(int64_t ns);
+};
+
+/**
+ * Simulated clock that only moves when told to.  SleepUntilNs() jumps
+ * straight to the requested time, so sleeping loops run as fast as possible.
+ */
+class ManualClock : public IClockSource {
+public:
+	ManualClock(int64_t startNs = 0);
+	int64_t NowNs();
+	void SleepUntilNs(int64_t ns);
+	void SetNs(int64_t ns);
+	void AdvanceNs(int64_t ns);
+private:
+	std::atomic<int64_t> _now;
+};
+
+/**
+ * Process wide monotonic time in nanoseconds.
+ */
+class Timebase {
+public:
+	static int64_t NowNs();
+	static double NowSeconds();
+	static void SleepUntilNs(int64_t ns);
+	static void SetClockSource(IClockSource *source);
+	static IClockSource * GetClockSource();
+};
+
+}
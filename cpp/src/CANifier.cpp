@@ -25,11 +25,18 @@
 #include "ctre/phoenix/CANifier.h"
 #include "ctre/phoenix/CCI/CANifier_CCI.h"
 #include "ctre/phoenix/CTRLogger.h"
+#include "ctre/phoenix/MotorControl/DeviceCatalog.h"
 
 namespace CTRE {
 CANifier::CANifier(int deviceNumber): CANBusAddressable(deviceNumber)
 {
 	m_handle = c_CANifier_Create1(deviceNumber);
+	CTRE::MotorControl::DeviceCatalog::GetInstance().Register(this, deviceNumber);
+}
+
+CANifier::~CANifier()
+{
+	CTRE::MotorControl::DeviceCatalog::GetInstance().Unregister(this);
 }
 
 CTR_Code CANifier::SetLEDOutput(double percentOutput, LEDChannel ledChannel) {
@@ -1,25 +1,252 @@
 #include "ctre/phoenix/CTRLogger.h"
 #include "ctre/phoenix/CCI/Logger_CCI.h" // c_Logger_*
+#include "ctre/phoenix/DiagnosticChannel.h"
+#include "ctre/phoenix/Logging/BinaryRingLog.h"
+#include "ctre/phoenix/Timebase.h"
 #include <execinfo.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 namespace CTRE {
-	
+
+static const int kMaxFrames = 16;
+static const uint32_t kRingSize = 256; /* power of two */
+static const int kMaxOrigins = 256;
+static const int kMaxText = 128;
+/* ids of origins given as text, kept clear of the Origin() table */
+static const int kTextOriginBit = 0x40000000;
+
+/* One pending log entry.  seq implements a bounded multi-producer queue:
+ * a slot is free for the producer at position p when seq == p, and
+ * ready for the writer when seq == p + 1. */
+struct LogRecord {
+	std::atomic<uint32_t> seq;
+	CTR_Code code;
+	int originId;
+	uint32_t suppressed;
+	bool hasText;
+	char text[kMaxText];
+	int frameCount;
+	int64_t timestampNs;
+	void *frames[kMaxFrames];
+};
+
+struct LogRing {
+	LogRecord records[kRingSize];
+	std::atomic<uint32_t> head;
+	uint32_t tail = 0; /* writer thread only */
+	std::atomic<uint32_t> logged;
+	std::atomic<uint32_t> dropped;
+
+	/* origin names, entries below originCount are immutable */
+	std::string origins[kMaxOrigins];
+	std::atomic<int> originCount;
+	std::unordered_map<std::string, int> originIds;
+	std::mutex originLock;
+
+	std::atomic<bool> running;
+	std::thread writer;
+	std::atomic<Logging::BinaryRingLog*> binaryLog;
+
+	LogRing() :
+			head(0), logged(0), dropped(0), originCount(0), running(false), binaryLog(nullptr) {
+		for (uint32_t i = 0; i < kRingSize; ++i)
+			records[i].seq.store(i, std::memory_order_relaxed);
+	}
+	/* Close() was never called, stop the writer so exit does not terminate */
+	~LogRing() {
+		running.store(false, std::memory_order_release);
+		if (writer.joinable())
+			writer.join();
+	}
+};
+static LogRing & Ring() {
+	static LogRing ring;
+	return ring;
+}
+
+/* Hand one entry to the binary log with raw frames, or symbolize it for the driver logger */
+static CTR_Code Write(CTR_Code code, int originId, const char *text, uint32_t suppressed, int64_t timestampNs,
+		void * const *frames, int frameCount) {
+	LogRing & ring = Ring();
+	const char *origin = "";
+	if (text != nullptr)
+		origin = text;
+	else if (originId >= 0 && originId < ring.originCount.load(std::memory_order_acquire))
+		origin = ring.origins[originId].c_str();
+
+	char stamp[64];
+	if (suppressed > 0)
+		snprintf(stamp, sizeof(stamp), "at %.6f s, %u repeats suppressed\n", (double) timestampNs * 1e-9, (unsigned int) suppressed);
+	else
+		snprintf(stamp, sizeof(stamp), "at %.6f s\n", (double) timestampNs * 1e-9);
+
+	/* Binary records keep the addresses, ctr_log_decode symbolizes them */
+	Logging::BinaryRingLog *binaryLog = ring.binaryLog.load(std::memory_order_acquire);
+	if (binaryLog != nullptr && binaryLog->Write(code, 3, timestampNs, origin, stamp, frames, frameCount))
+		return code;
+
+	std::string stackTrace = stamp;
+	char **strings = backtrace_symbols(frames, frameCount);
+	if (strings != nullptr) {
+		for (int i = 0; i < frameCount; i++) {
+			stackTrace += strings[i];
+			stackTrace += "\n";
+		}
+		free(strings);
+	}
+	return c_Logger_Log(code, origin, 3, stackTrace.c_str());
+}
+
 void CTRLogger::Open(int language) {
 	c_Logger_Open(language, true);
+
+	/* First backtrace() call loads the unwinder, do it here rather than in a loop */
+	void *warm[2];
+	backtrace(warm, 2);
+
+	LogRing & ring = Ring();
+	if (ring.running.exchange(true) == false)
+		ring.writer = std::thread(&CTRLogger::WriterLoop);
 }
+/**
+ * Get the id for an origin name, for use with Log(CTR_Code, int).
+ * Looking the name up takes a lock, so do it once at setup.
+ * @return id, or -1 if the origin table is full.
+ */
+int CTRLogger::Origin(const std::string & origin) {
+	LogRing & ring = Ring();
+	std::lock_guard<std::mutex> lock(ring.originLock);
+	auto it = ring.originIds.find(origin);
+	if (it != ring.originIds.end())
+		return it->second;
+	int id = ring.originCount.load(std::memory_order_relaxed);
+	if (id >= kMaxOrigins)
+		return -1;
+	ring.origins[id] = origin;
+	ring.originIds[origin] = id;
+	ring.originCount.store(id + 1, std::memory_order_release);
+	return id;
+}
+/**
+ * Log with free-form origin text.  Rate limiting keys on a hash of the text,
+ * so prefer Origin() ids for anything logged repeatedly.
+ */
 CTR_Code CTRLogger::Log(CTR_Code code, std::string origin) {
-	void *buf[100];
-	char **strings;
-	int size = backtrace(buf, 100);
-	strings = backtrace_symbols(buf, size);
-	std::string stackTrace;
-	for(int i = 1; i < size; i++) {
-		stackTrace += strings[i];
-		stackTrace += "\n";
+	uint32_t hash = 2166136261u;
+	for (char ch : origin)
+		hash = (hash ^ (unsigned char) ch) * 16777619u;
+	return Record(code, (int) (hash | kTextOriginBit) & 0x7FFFFFFF, origin.c_str());
+}
+/**
+ * Log against an origin id from Origin(), no allocation or locking.
+ * @return code, the driver's result is not known until the entry is written.
+ */
+CTR_Code CTRLogger::Log(CTR_Code code, int originId) {
+	return Record(code, originId, nullptr);
+}
+/**
+ * Log message text in place of the origin name, rate limited against originId.
+ * Text longer than 127 characters is cut short.
+ */
+CTR_Code CTRLogger::Log(CTR_Code code, int originId, const char *message) {
+	return Record(code, originId, message);
+}
+CTR_Code CTRLogger::Record(CTR_Code code, int originId, const char *text) {
+	uint32_t suppressed;
+	if (DiagnosticChannel::Allow(code, originId, suppressed) == false)
+		return code;
+
+	/* Skip our own frame, Log() is usually a tail call into here */
+	void *buf[kMaxFrames + 1];
+	int size = backtrace(buf, kMaxFrames + 1) - 1;
+	if (size < 0)
+		size = 0;
+	int64_t now = Timebase::NowNs();
+
+	LogRing & ring = Ring();
+	if (ring.running.load(std::memory_order_acquire) == false) {
+		ring.logged.fetch_add(1, std::memory_order_relaxed);
+		return Write(code, originId, text, suppressed, now, buf + 1, size);
 	}
-	return c_Logger_Log(code, origin.c_str(), 3, stackTrace.c_str());
+
+	/* Claim a slot, drop the entry rather than wait if the writer is behind */
+	uint32_t pos = ring.head.load(std::memory_order_relaxed);
+	LogRecord *rec;
+	for (;;) {
+		rec = &ring.records[pos & (kRingSize - 1)];
+		int32_t diff = (int32_t) (rec->seq.load(std::memory_order_acquire) - pos);
+		if (diff == 0) {
+			if (ring.head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			ring.dropped.fetch_add(1, std::memory_order_relaxed);
+			return code;
+		} else {
+			pos = ring.head.load(std::memory_order_relaxed);
+		}
+	}
+	rec->code = code;
+	rec->originId = originId;
+	rec->suppressed = suppressed;
+	rec->hasText = (text != nullptr);
+	if (text != nullptr) {
+		strncpy(rec->text, text, kMaxText - 1);
+		rec->text[kMaxText - 1] = 0;
+	}
+	rec->timestampNs = now;
+	rec->frameCount = size;
+	for (int i = 0; i < size; ++i)
+		rec->frames[i] = buf[i + 1];
+	rec->seq.store(pos + 1, std::memory_order_release);
+	ring.logged.fetch_add(1, std::memory_order_relaxed);
+	return code;
+}
+void CTRLogger::WriterLoop() {
+	LogRing & ring = Ring();
+	for (;;) {
+		bool running = ring.running.load(std::memory_order_acquire);
+		/* Drain everything published so far */
+		for (;;) {
+			LogRecord & rec = ring.records[ring.tail & (kRingSize - 1)];
+			if (rec.seq.load(std::memory_order_acquire) != ring.tail + 1)
+				break;
+			Write(rec.code, rec.originId, rec.hasText ? rec.text : nullptr, rec.suppressed, rec.timestampNs,
+					rec.frames, rec.frameCount);
+			rec.seq.store(ring.tail + kRingSize, std::memory_order_release);
+			++ring.tail;
+		}
+		if (running == false)
+			break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+}
+/** Entries accepted by Log(), including those still waiting to be written. */
+uint32_t CTRLogger::GetLogCount() {
+	return Ring().logged.load(std::memory_order_relaxed);
+}
+/** Entries lost because the ring was full. */
+uint32_t CTRLogger::GetDropCount() {
+	return Ring().dropped.load(std::memory_order_relaxed);
+}
+/**
+ * Write entries into a binary ring log instead of the driver's text log,
+ * nullptr to go back to the text log.  The log must stay open while set.
+ */
+void CTRLogger::SetBinaryLog(Logging::BinaryRingLog *log) {
+	Ring().binaryLog.store(log, std::memory_order_release);
 }
 void CTRLogger::Close() {
+	/* Writer drains what is left before it exits */
+	LogRing & ring = Ring();
+	if (ring.running.exchange(false) == true && ring.writer.joinable())
+		ring.writer.join();
 	c_Logger_Close();
 }
 //void CTRLogger::Description(CTR_Code code, const char *&shrt, const char *&lng) {
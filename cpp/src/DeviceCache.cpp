@@ -0,0 +1,188 @@
+#include "ctre/phoenix/DeviceCache.h"
+
+namespace CTRE {
+
+DeviceCache::DeviceCache() :
+		_refreshes(0), _driverCalls(0), _cachedReads(0) {
+}
+/**
+ * Register a Pigeon, returns its existing handle if already registered.
+ */
+DeviceCache::Handle DeviceCache::Add(CTRE::PigeonIMU *pigeon) {
+	Handle handle = Find(pigeon);
+	if (handle >= 0)
+		return handle;
+	PigeonSnapshot snap = {};
+	snap.state = CTRE::PigeonIMU::PigeonState::NoComm;
+	_pigeonDevices.push_back(pigeon);
+	_pigeons.push_back(snap);
+	return (Handle) _pigeons.size() - 1;
+}
+/**
+ * Register a motor controller, returns its existing handle if already registered.
+ * @param fields	MotorField bits to read each refresh, re-adding widens the set.
+ */
+DeviceCache::Handle DeviceCache::Add(CTRE::MotorControl::IMotorController *motorController, int fields) {
+	Handle handle = Find(motorController);
+	if (handle >= 0) {
+		_motorFields[handle] |= fields;
+		return handle;
+	}
+	MotorSnapshot snap = {};
+	_motorDevices.push_back(motorController);
+	_motorFields.push_back(fields);
+	_motors.push_back(snap);
+	return (Handle) _motors.size() - 1;
+}
+DeviceCache::Handle DeviceCache::Find(CTRE::PigeonIMU *pigeon) {
+	for (unsigned int i = 0; i < _pigeonDevices.size(); ++i)
+		if (_pigeonDevices[i] == pigeon)
+			return (Handle) i;
+	return -1;
+}
+DeviceCache::Handle DeviceCache::Find(CTRE::MotorControl::IMotorController *motorController) {
+	for (unsigned int i = 0; i < _motorDevices.size(); ++i)
+		if (_motorDevices[i] == motorController)
+			return (Handle) i;
+	return -1;
+}
+/**
+ * Read every registered device once.  Call at the start of a tick,
+ * before any consumer runs.
+ */
+void DeviceCache::Refresh() {
+	if (_replay) {
+		_refreshes.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	uint64_t calls = 0;
+	for (unsigned int i = 0; i < _pigeons.size(); ++i) {
+		CTRE::PigeonIMU *pigeon = _pigeonDevices[i];
+		PigeonSnapshot & snap = _pigeons[i];
+		snap.yprError = pigeon->GetYawPitchRoll(snap.ypr);
+		snap.gyroError = pigeon->GetRawGyro(snap.rawGyro);
+		snap.state = pigeon->GetState();
+		calls += 3;
+	}
+	for (unsigned int i = 0; i < _motors.size(); ++i) {
+		CTRE::MotorControl::IMotorController *mc = _motorDevices[i];
+		MotorSnapshot & snap = _motors[i];
+		int fields = _motorFields[i];
+		if (fields & Position) {
+			snap.position = mc->GetSelectedSensorPosition();
+			++calls;
+		}
+		if (fields & Velocity) {
+			snap.velocity = mc->GetSelectedSensorVelocity();
+			++calls;
+		}
+		if (fields & OutputCurrent) {
+			snap.currentError = mc->GetOutputCurrent(snap.outputCurrent);
+			++calls;
+		}
+		if (fields & BusVoltage) {
+			snap.voltageError = mc->GetBusVoltage(snap.busVoltage);
+			++calls;
+		}
+		if (fields & OutputPercent) {
+			snap.percentError = mc->GetMotorOutputPercent(snap.outputPercent);
+			++calls;
+		}
+		if (fields & Temperature) {
+			snap.temperatureError = mc->GetTemperature(snap.temperature);
+			++calls;
+		}
+	}
+	_driverCalls.fetch_add(calls, std::memory_order_relaxed);
+	_refreshes.fetch_add(1, std::memory_order_relaxed);
+}
+/**
+ * In replay the snapshots are filled from a recording (see TelemetryReplay)
+ * and Refresh() leaves them alone instead of reading the devices.
+ */
+void DeviceCache::SetReplay(bool replay) {
+	_replay = replay;
+}
+bool DeviceCache::IsReplay() {
+	return _replay;
+}
+int DeviceCache::GetPigeonCount() {
+	return (int) _pigeons.size();
+}
+int DeviceCache::GetMotorCount() {
+	return (int) _motors.size();
+}
+CTRE::PigeonIMU * DeviceCache::GetPigeonDevice(Handle pigeon) {
+	return _pigeonDevices[pigeon];
+}
+CTRE::MotorControl::IMotorController * DeviceCache::GetMotorDevice(Handle motor) {
+	return _motorDevices[motor];
+}
+int DeviceCache::GetYawPitchRoll(Handle pigeon, double ypr[3]) {
+	const PigeonSnapshot & snap = _pigeons[pigeon];
+	ypr[0] = snap.ypr[0];
+	ypr[1] = snap.ypr[1];
+	ypr[2] = snap.ypr[2];
+	CountRead();
+	return snap.yprError;
+}
+int DeviceCache::GetRawGyro(Handle pigeon, double xyz_dps[3]) {
+	const PigeonSnapshot & snap = _pigeons[pigeon];
+	xyz_dps[0] = snap.rawGyro[0];
+	xyz_dps[1] = snap.rawGyro[1];
+	xyz_dps[2] = snap.rawGyro[2];
+	CountRead();
+	return snap.gyroError;
+}
+CTRE::PigeonIMU::PigeonState DeviceCache::GetState(Handle pigeon) {
+	CountRead();
+	return _pigeons[pigeon].state;
+}
+int DeviceCache::GetSelectedSensorPosition(Handle motor) {
+	CountRead();
+	return _motors[motor].position;
+}
+int DeviceCache::GetSelectedSensorVelocity(Handle motor) {
+	CountRead();
+	return _motors[motor].velocity;
+}
+ErrorCode DeviceCache::GetOutputCurrent(Handle motor, float & param) {
+	CountRead();
+	param = _motors[motor].outputCurrent;
+	return _motors[motor].currentError;
+}
+ErrorCode DeviceCache::GetBusVoltage(Handle motor, float & param) {
+	CountRead();
+	param = _motors[motor].busVoltage;
+	return _motors[motor].voltageError;
+}
+ErrorCode DeviceCache::GetMotorOutputPercent(Handle motor, float & param) {
+	CountRead();
+	param = _motors[motor].outputPercent;
+	return _motors[motor].percentError;
+}
+ErrorCode DeviceCache::GetTemperature(Handle motor, float & param) {
+	CountRead();
+	param = _motors[motor].temperature;
+	return _motors[motor].temperatureError;
+}
+void DeviceCache::GetStats(Stats & stats) {
+	stats.refreshes = _refreshes.load(std::memory_order_relaxed);
+	stats.driverCalls = _driverCalls.load(std::memory_order_relaxed);
+	stats.cachedReads = _cachedReads.load(std::memory_order_relaxed);
+}
+/**
+ * Driver calls avoided so far: reads served from the table minus the reads
+ * Refresh() made to fill it.  Negative when fields are refreshed but unused.
+ */
+int64_t DeviceCache::GetCallsSaved() {
+	return (int64_t) _cachedReads.load(std::memory_order_relaxed)
+			- (int64_t) _driverCalls.load(std::memory_order_relaxed);
+}
+void DeviceCache::ResetStats() {
+	_refreshes = 0;
+	_driverCalls = 0;
+	_cachedReads = 0;
+}
+
+} // namespace CTRE
@@ -0,0 +1,186 @@
+#include "ctre/phoenix/DiagnosticChannel.h"
+#include "ctre/phoenix/CTRLogger.h"
+#include "ctre/phoenix/Timebase.h"
+#include "HAL/DriverStation.h"
+#include <atomic>
+#include <stdio.h>
+
+namespace CTRE {
+
+static const int kTableBits = 8;
+static const int kTableSize = 1 << kTableBits;
+static const int kUseDefault = -2;
+
+/* One (code, origin) pair.  key is claimed once and never released,
+ * zero marks a free slot (OK is never counted so no key is zero). */
+struct DiagnosticEntry {
+	std::atomic<uint64_t> key;
+	std::atomic<uint32_t> count;
+	std::atomic<uint32_t> suppressed;
+	std::atomic<int64_t> nextAllowedNs;
+	std::atomic<int> periodMs;
+};
+
+struct DiagnosticTable {
+	DiagnosticEntry entries[kTableSize];
+	std::atomic<int> defaultPeriodMs;
+	std::atomic<uint32_t> overflow;
+
+	DiagnosticTable() :
+			defaultPeriodMs(1000), overflow(0) {
+		for (int i = 0; i < kTableSize; ++i) {
+			entries[i].key.store(0, std::memory_order_relaxed);
+			entries[i].count.store(0, std::memory_order_relaxed);
+			entries[i].suppressed.store(0, std::memory_order_relaxed);
+			entries[i].nextAllowedNs.store(0, std::memory_order_relaxed);
+			entries[i].periodMs.store(kUseDefault, std::memory_order_relaxed);
+		}
+	}
+};
+static DiagnosticTable & Table() {
+	static DiagnosticTable table;
+	return table;
+}
+
+static uint64_t MakeKey(CTR_Code code, int originId) {
+	return ((uint64_t) (uint32_t) code << 32) | (uint32_t) originId;
+}
+/* Find the entry for key, claiming a free slot if it is new.  nullptr if the table is full. */
+static DiagnosticEntry * Lookup(uint64_t key) {
+	DiagnosticTable & table = Table();
+	unsigned int idx = (unsigned int) ((key * 0x9E3779B97F4A7C15ULL) >> (64 - kTableBits));
+	for (int probe = 0; probe < kTableSize; ++probe) {
+		DiagnosticEntry & e = table.entries[(idx + probe) & (kTableSize - 1)];
+		uint64_t current = e.key.load(std::memory_order_acquire);
+		if (current == key)
+			return &e;
+		if (current == 0) {
+			if (e.key.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+				return &e;
+			if (current == key)
+				return &e;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * Get the id for an origin name.  Takes a lock, so call once at setup
+ * and keep the id.
+ */
+int DiagnosticChannel::Origin(const std::string & origin) {
+	return CTRLogger::Origin(origin);
+}
+/**
+ * Count one occurrence and decide whether it should be passed on.
+ * @param suppressed	Filled with how many occurrences were held back since the last one passed.
+ * @return true if the rate limit allows this one through, always true for OK.
+ */
+bool DiagnosticChannel::Allow(CTR_Code code, int originId, uint32_t & suppressed) {
+	suppressed = 0;
+	/* Success is informational and never limited */
+	if (code == OK)
+		return true;
+	DiagnosticEntry *e = Lookup(MakeKey(code, originId));
+	if (e == nullptr) {
+		/* Table full, let it through rather than lose it */
+		Table().overflow.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	e->count.fetch_add(1, std::memory_order_relaxed);
+
+	int periodMs = e->periodMs.load(std::memory_order_relaxed);
+	if (periodMs == kUseDefault)
+		periodMs = Table().defaultPeriodMs.load(std::memory_order_relaxed);
+	if (periodMs < 0) {
+		e->suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	int64_t now = Timebase::NowNs();
+	int64_t next = e->nextAllowedNs.load(std::memory_order_relaxed);
+	if (now < next || e->nextAllowedNs.compare_exchange_strong(next, now + (int64_t) periodMs * 1000000LL) == false) {
+		e->suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	suppressed = e->suppressed.exchange(0, std::memory_order_relaxed);
+	return true;
+}
+/**
+ * Log code against origin through CTRLogger, subject to the rate limit.
+ */
+CTR_Code DiagnosticChannel::Report(CTR_Code code, int originId) {
+	return CTRLogger::Log(code, originId);
+}
+/**
+ * Send a message to the driver station, subject to the rate limit.
+ * Negative codes are sent as errors, positive ones as warnings.
+ */
+CTR_Code DiagnosticChannel::SendError(CTR_Code code, int originId, const char *details) {
+	uint32_t suppressed;
+	if (Allow(code, originId, suppressed) == false)
+		return code;
+	if (suppressed == 0) {
+		HAL_SendError(code < 0, 1, false, details, "", "", true);
+	} else {
+		char line[256];
+		snprintf(line, sizeof(line), "%s (%u repeats suppressed)", details, (unsigned int) suppressed);
+		HAL_SendError(code < 0, 1, false, line, "", "", true);
+	}
+	return code;
+}
+/**
+ * Minimum time between messages for pairs without their own period.
+ * Zero passes every occurrence, negative only counts them.
+ */
+void DiagnosticChannel::SetDefaultPeriodMs(int periodMs) {
+	Table().defaultPeriodMs.store(periodMs < 0 ? -1 : periodMs, std::memory_order_relaxed);
+}
+/**
+ * Minimum time between messages for one pair.
+ * Zero passes every occurrence, negative only counts them.
+ */
+void DiagnosticChannel::SetPeriodMs(CTR_Code code, int originId, int periodMs) {
+	DiagnosticEntry *e = Lookup(MakeKey(code, originId));
+	if (e != nullptr)
+		e->periodMs.store(periodMs < 0 ? -1 : periodMs, std::memory_order_relaxed);
+}
+/**
+ * Copy out the counters of every pair seen so far.
+ * @return number of summaries filled.
+ */
+int DiagnosticChannel::GetSummaries(Summary *summaries, int capacity) {
+	DiagnosticTable & table = Table();
+	int n = 0;
+	for (int i = 0; i < kTableSize && n < capacity; ++i) {
+		DiagnosticEntry & e = table.entries[i];
+		uint64_t key = e.key.load(std::memory_order_acquire);
+		uint32_t count = e.count.load(std::memory_order_relaxed);
+		if (key == 0 || count == 0)
+			continue;
+		summaries[n].code = (CTR_Code) (int32_t) (uint32_t) (key >> 32);
+		summaries[n].originId = (int) (int32_t) (uint32_t) key;
+		summaries[n].count = count;
+		summaries[n].suppressed = e.suppressed.load(std::memory_order_relaxed);
+		++n;
+	}
+	return n;
+}
+/** Reports let through because the table had no room for a new pair. */
+uint32_t DiagnosticChannel::GetOverflowCount() {
+	return Table().overflow.load(std::memory_order_relaxed);
+}
+/**
+ * Clear all counters and rate limit timers, pairs and their periods are kept.
+ */
+void DiagnosticChannel::Reset() {
+	DiagnosticTable & table = Table();
+	for (int i = 0; i < kTableSize; ++i) {
+		table.entries[i].count.store(0, std::memory_order_relaxed);
+		table.entries[i].suppressed.store(0, std::memory_order_relaxed);
+		table.entries[i].nextAllowedNs.store(0, std::memory_order_relaxed);
+	}
+	table.overflow.store(0, std::memory_order_relaxed);
+}
+
+} // namespace CTRE
@@ -0,0 +1,225 @@
+#include "ctre/phoenix/Drive/Odometry.h"
+#include "ctre/phoenix/Timebase.h"
+
+namespace CTRE { namespace Drive {
+
+Odometry::Odometry(CTRE::PigeonIMU *pigeonImu, CTRE::MotorControl::IMotorController *left,
+		CTRE::MotorControl::IMotorController *right, float distancePerTick)
+{
+	_pidgey = pigeonImu;
+	_wheels[0] = left;
+	_wheels[1] = right;
+	_wheels[2] = nullptr;
+	_wheels[3] = nullptr;
+	_wheelCount = 2;
+	_distancePerTick = distancePerTick;
+	Init();
+}
+Odometry::Odometry(CTRE::PigeonIMU *pigeonImu, CTRE::MotorControl::IMotorController *leftFront,
+		CTRE::MotorControl::IMotorController *leftRear, CTRE::MotorControl::IMotorController *rightFront,
+		CTRE::MotorControl::IMotorController *rightRear, float distancePerTick)
+{
+	_pidgey = pigeonImu;
+	_wheels[0] = leftFront;
+	_wheels[1] = leftRear;
+	_wheels[2] = rightFront;
+	_wheels[3] = rightRear;
+	_wheelCount = 4;
+	_distancePerTick = distancePerTick;
+	Init();
+}
+Odometry::~Odometry(){
+	StopThread();
+	delete _history;
+}
+void Odometry::Init(){
+	_seq = 0;
+	_pubX = 0;
+	_pubY = 0;
+	_pubHeading = 0;
+	_pubTimestamp = 0;
+	_resetPending = false;
+	_resetX = 0;
+	_resetY = 0;
+	_resetHeading = 0;
+	_threadRunning = false;
+}
+/**
+ * Integrate one step.  Only call from a single thread at a time,
+ * either the scheduler running this loopable or the odometry thread.
+ */
+void Odometry::Update(){
+	int ticks[4];
+	for (int i = 0; i < _wheelCount; ++i)
+		ticks[i] = _wheels[i]->GetSelectedSensorPosition();
+
+	bool yawGood = false;
+	double yaw = 0;
+	if (_pidgey->GetState() == CTRE::PigeonIMU::PigeonState::Ready) {
+		double YPR[3];
+		if (_pidgey->GetYawPitchRoll(YPR) == 0) {
+			yaw = YPR[0];
+			yawGood = true;
+		}
+	}
+
+	if (_resetPending.exchange(false, std::memory_order_acquire)) {
+		_pose.x = _resetX.load(std::memory_order_relaxed);
+		_pose.y = _resetY.load(std::memory_order_relaxed);
+		_pose.heading = _resetHeading.load(std::memory_order_relaxed);
+		/* Offset the Pigeon yaw instead of re-zeroing it, a SetYaw would
+		 * only show up a status frame later */
+		_yawOffsetPending = true;
+		_hasBaseline = false;
+	}
+	if (_yawOffsetPending && yawGood) {
+		_yawOffset = _pose.heading - yaw;
+		_yawOffsetPending = false;
+	}
+
+	/* Hold the last heading if the Pigeon drops out, encoders still count */
+	double newHeading = _pose.heading;
+	if (yawGood && _yawOffsetPending == false)
+		newHeading = yaw + _yawOffset;
+
+	if (_hasBaseline == false) {
+		/* First sample only establishes the encoder baseline */
+		for (int i = 0; i < _wheelCount; ++i)
+			_previousTicks[i] = ticks[i];
+		_hasBaseline = true;
+		_pose.heading = newHeading;
+		Publish(Timebase::NowSeconds());
+		return;
+	}
+
+	double d[4];
+	for (int i = 0; i < _wheelCount; ++i) {
+		d[i] = (double)(ticks[i] - _previousTicks[i]) * _distancePerTick;
+		_previousTicks[i] = ticks[i];
+	}
+
+	/* Sensor phase must be set so every wheel counts up when driving forward */
+	double forward, strafe;
+	if (_wheelCount == 2) {
+		forward = (d[0] + d[1]) * 0.5;
+		strafe = 0;
+	} else {
+		forward = (d[0] + d[1] + d[2] + d[3]) * 0.25;
+		/* Left positive, inverse of the mecanum strafe mix */
+		strafe = (-d[0] + d[1] + d[2] - d[3]) * 0.25;
+	}
+	_pose.Integrate(forward, strafe, newHeading);
+	Publish(Timebase::NowSeconds());
+}
+void Odometry::Publish(double timestampSec){
+	/* Odd sequence marks a write in progress, readers retry */
+	unsigned int seq = _seq.load(std::memory_order_relaxed);
+	_seq.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	_pubX.store(_pose.x, std::memory_order_relaxed);
+	_pubY.store(_pose.y, std::memory_order_relaxed);
+	_pubHeading.store(_pose.heading, std::memory_order_relaxed);
+	_pubTimestamp.store(timestampSec, std::memory_order_relaxed);
+	_seq.store(seq + 2, std::memory_order_release);
+
+	if (_history != nullptr)
+		_history->Push(timestampSec, _pose);
+}
+CTRE::Motion::Pose2d Odometry::GetPose(){
+	double timestampSec;
+	return GetPose(timestampSec);
+}
+/**
+ * Latest published pose, safe to call from any thread.
+ * @param timestampSec	Timebase time the pose was integrated at, in seconds.
+ */
+CTRE::Motion::Pose2d Odometry::GetPose(double & timestampSec){
+	CTRE::Motion::Pose2d pose;
+	unsigned int before, after;
+	do {
+		before = _seq.load(std::memory_order_acquire);
+		pose.x = _pubX.load(std::memory_order_relaxed);
+		pose.y = _pubY.load(std::memory_order_relaxed);
+		pose.heading = _pubHeading.load(std::memory_order_relaxed);
+		timestampSec = _pubTimestamp.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		after = _seq.load(std::memory_order_relaxed);
+	} while ((before & 1) || before != after);
+	return pose;
+}
+/**
+ * Move the estimate to a known pose.  The Pigeon yaw is left alone, headings
+ * are offset from it from then on.  Takes effect on the next Update().
+ */
+void Odometry::ResetPose(const CTRE::Motion::Pose2d & pose){
+	_resetX.store(pose.x, std::memory_order_relaxed);
+	_resetY.store(pose.y, std::memory_order_relaxed);
+	_resetHeading.store(pose.heading, std::memory_order_relaxed);
+	_resetPending.store(true, std::memory_order_release);
+}
+/** Number of poses published so far. */
+unsigned int Odometry::GetUpdateCount(){
+	return _seq.load(std::memory_order_acquire) / 2;
+}
+/**
+ * Keep the last capacity poses so GetPoseAt() can look back in time.
+ * Call once before starting updates, storage is allocated here.
+ */
+void Odometry::EnableHistory(int capacity){
+	if (_history != nullptr)
+		return;
+	_history = new CTRE::Signals::TimeHistory<CTRE::Motion::Pose2d>(capacity);
+}
+/**
+ * Pose at a past Timebase time in seconds, e.g. when a vision frame was captured.
+ * Safe to call from any thread, retries if an update lands mid-lookup.
+ * @return false if history is disabled or the time is outside the stored range.
+ */
+bool Odometry::GetPoseAt(double timestampSec, CTRE::Motion::Pose2d & pose){
+	if (_history == nullptr)
+		return false;
+	return _history->Get(timestampSec, pose);
+}
+/**
+ * Run Update() on a dedicated thread instead of a scheduler.
+ * @param periodUs	Update period in microseconds, 5000 is 200Hz.
+ * @return false if the thread is already running.
+ */
+bool Odometry::StartThread(int periodUs){
+	if (_threadRunning.exchange(true))
+		return false;
+	_thread = std::thread(&Odometry::ThreadLoop, this, periodUs);
+	return true;
+}
+void Odometry::StopThread(){
+	if (_threadRunning.exchange(false) == false)
+		return;
+	if (_thread.joinable())
+		_thread.join();
+}
+void Odometry::ThreadLoop(int periodUs){
+	int64_t period = (int64_t)(periodUs > 0 ? periodUs : 5000) * 1000;
+	int64_t next = Timebase::NowNs();
+	while (_threadRunning.load(std::memory_order_relaxed)) {
+		Update();
+		/* Absolute deadlines so the period does not drift with Update() time */
+		next += period;
+		int64_t now = Timebase::NowNs();
+		if (next < now)
+			next = now;
+		Timebase::SleepUntilNs(next);
+	}
+}
+void Odometry::OnStart(){
+	_hasBaseline = false;
+}
+void Odometry::OnLoop(){
+	Update();
+}
+bool Odometry::IsDone(){
+	return false;
+}
+void Odometry::OnStop(){
+}
+
+}}
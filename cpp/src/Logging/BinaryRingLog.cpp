@@ -0,0 +1,171 @@
+#include "ctre/phoenix/Logging/BinaryRingLog.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace CTRE { namespace Logging {
+
+BinaryRingLog::BinaryRingLog() :
+		_next(0) {
+}
+BinaryRingLog::~BinaryRingLog() {
+	Close();
+}
+std::string BinaryRingLog::SegmentPath(const std::string & directory, int segmentIndex) {
+	char name[32];
+	snprintf(name, sizeof(name), "/ctre_log_%d.bin", segmentIndex);
+	return directory + name;
+}
+/**
+ * Map the segment files in directory, creating and preallocating any that
+ * are missing.  Existing segments with a matching layout are kept and
+ * numbering resumes after the newest record found in them.
+ * @return false if any segment could not be created or mapped.
+ */
+bool BinaryRingLog::Open(const std::string & directory, int segmentCount, int recordsPerSegment) {
+	Close();
+	if (segmentCount < 1 || recordsPerSegment < 1)
+		return false;
+	_recordsPerSegment = recordsPerSegment;
+
+	uint64_t newest = 0;
+	for (int i = 0; i < segmentCount; ++i) {
+		Segment segment;
+		if (OpenSegment(directory, i, segment) == false) {
+			Close();
+			return false;
+		}
+		_segments.push_back(segment);
+		for (int r = 0; r < recordsPerSegment; ++r) {
+			uint64_t seq = segment.records[r].seq;
+			if (seq > newest)
+				newest = seq;
+		}
+	}
+	/* Segment headers record their layout, fix them up for this ring size */
+	for (int i = 0; i < segmentCount; ++i)
+		_segments[i].header->segmentCount = (uint32_t) segmentCount;
+	_next = newest;
+	return true;
+}
+bool BinaryRingLog::OpenSegment(const std::string & directory, int segmentIndex, Segment & segment) {
+	size_t length = (size_t) (_recordsPerSegment + 1) * kBinaryLogRecordSize;
+	std::string path = SegmentPath(directory, segmentIndex);
+
+	int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		return false;
+	}
+	bool fresh = ((size_t) st.st_size != length);
+	if (fresh) {
+		/* Reserve the blocks now so writing never has to allocate */
+		if (ftruncate(fd, (off_t) length) != 0) {
+			close(fd);
+			return false;
+		}
+		posix_fallocate(fd, 0, (off_t) length);
+	}
+	void *map = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED) {
+		close(fd);
+		return false;
+	}
+	segment.fd = fd;
+	segment.length = length;
+	segment.header = (BinaryLogSegmentHeader *) map;
+	segment.records = (BinaryLogRecord *) ((char *) map + kBinaryLogRecordSize);
+
+	BinaryLogSegmentHeader *h = segment.header;
+	if (fresh || memcmp(h->magic, kBinaryLogMagic, sizeof(h->magic)) != 0 || h->version != kBinaryLogVersion
+			|| h->recordSize != (uint32_t) kBinaryLogRecordSize || h->recordsPerSegment != (uint32_t) _recordsPerSegment
+			|| h->segmentIndex != (uint32_t) segmentIndex) {
+		memset(map, 0, length);
+		memcpy(h->magic, kBinaryLogMagic, sizeof(h->magic));
+		h->version = kBinaryLogVersion;
+		h->recordSize = kBinaryLogRecordSize;
+		h->recordsPerSegment = (uint32_t) _recordsPerSegment;
+		h->segmentIndex = (uint32_t) segmentIndex;
+	}
+	return true;
+}
+/**
+ * Unmap and close every segment, waiting for the data to reach the file.
+ */
+void BinaryRingLog::Close() {
+	for (auto & segment : _segments) {
+		msync(segment.header, segment.length, MS_SYNC);
+		munmap(segment.header, segment.length);
+		close(segment.fd);
+	}
+	_segments.clear();
+}
+bool BinaryRingLog::IsOpen() {
+	return _segments.empty() == false;
+}
+/**
+ * Copy one record into the ring.  Origin and message are cut short
+ * to fit the record, origin first.
+ * @param frames	Backtrace addresses, stored raw for the decoder to symbolize.
+ * 					Only the first kBinaryLogMaxFrames are kept.
+ * @return false if the log is not open.
+ */
+bool BinaryRingLog::Write(int32_t code, int32_t hierarchy, int64_t timestampNs, const char *origin, const char *message,
+		void * const *frames, int frameCount) {
+	if (_segments.empty())
+		return false;
+	uint64_t n = _next.fetch_add(1, std::memory_order_relaxed);
+	uint64_t segmentNumber = n / (uint64_t) _recordsPerSegment;
+	Segment & segment = _segments[segmentNumber % _segments.size()];
+	BinaryLogRecord *rec = &segment.records[n % (uint64_t) _recordsPerSegment];
+
+	if (n % (uint64_t) _recordsPerSegment == 0)
+		segment.header->generation = segmentNumber / _segments.size();
+
+	/* Invalidate the slot while it is half written */
+	__atomic_store_n(&rec->seq, 0, __ATOMIC_RELAXED);
+	rec->timestampNs = timestampNs;
+	rec->code = code;
+	rec->hierarchy = hierarchy;
+
+	size_t space = sizeof(rec->text);
+	size_t originLength = (origin != nullptr) ? strnlen(origin, space) : 0;
+	if (originLength > 0)
+		memcpy(rec->text, origin, originLength);
+	space -= originLength;
+	size_t messageLength = (message != nullptr) ? strnlen(message, space) : 0;
+	if (messageLength > 0)
+		memcpy(rec->text + originLength, message, messageLength);
+	rec->originLength = (uint16_t) originLength;
+	rec->messageLength = (uint16_t) messageLength;
+
+	if (frames == nullptr || frameCount < 0)
+		frameCount = 0;
+	if (frameCount > kBinaryLogMaxFrames)
+		frameCount = kBinaryLogMaxFrames;
+	for (int i = 0; i < frameCount; ++i)
+		rec->frames[i] = (uint64_t) (uintptr_t) frames[i];
+	rec->frameCount = (uint16_t) frameCount;
+
+	__atomic_store_n(&rec->seq, n + 1, __ATOMIC_RELEASE);
+	return true;
+}
+/**
+ * Ask the kernel to start writing dirty pages out, does not wait.
+ */
+void BinaryRingLog::Flush() {
+	for (auto & segment : _segments)
+		msync(segment.header, segment.length, MS_ASYNC);
+}
+/** Records written since the log was first created, including overwritten ones. */
+uint64_t BinaryRingLog::GetRecordCount() {
+	return _next.load(std::memory_order_relaxed);
+}
+
+}}
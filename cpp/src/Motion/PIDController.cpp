@@ -0,0 +1,53 @@
+#include "ctre/phoenix/Motion/PIDController.h"
+
+namespace CTRE { namespace Motion {
+
+void PIDController::Reset(){
+	_integral = 0;
+	_rate = 0;
+	_primed = false;
+}
+/**
+ * Derivative is taken from the change in measurement over dt.
+ * @param dt	Seconds since the last call.
+ * @return output clamped to +/- maxOutput.
+ */
+float PIDController::Calculate(const ServoParameters & params, float setpoint, float measurement, float dt, float maxOutput){
+	float rawRate = 0;
+	if (_primed && dt > 0)
+		rawRate = (measurement - _prevMeasurement) / dt;
+	return Calculate(params, setpoint, measurement, rawRate, dt, maxOutput);
+}
+/**
+ * Use when the sensor reports its own rate, e.g. Pigeon angular rate.
+ * @param measurementRate	Rate of change of the measurement in units per second.
+ */
+float PIDController::Calculate(const ServoParameters & params, float setpoint, float measurement, float measurementRate, float dt, float maxOutput){
+	/* Same math as PIDBatch::Calculate.  The first call after Reset()
+	 * has no previous sample, so nothing is integrated yet */
+	if (_primed == false)
+		dt = 0;
+	float error = setpoint - measurement;
+
+	_rate = _primed ? params.DFilter * _rate + (1.0f - params.DFilter) * measurementRate : measurementRate;
+	_prevMeasurement = measurement;
+	_primed = true;
+
+	/* Accumulate the I contribution itself so the clamp bounds what it can add to the output */
+	float iLimit = (params.IMax > 0) ? params.IMax : maxOutput;
+	float iTerm = _integral + params.I * error * dt;
+	if (iTerm > iLimit) iTerm = iLimit;
+	if (iTerm < -iLimit) iTerm = -iLimit;
+	_integral = iTerm;
+
+	float out = params.P * error + iTerm - params.D * _rate + params.F * setpoint;
+	if (out > maxOutput) out = maxOutput;
+	if (out < -maxOutput) out = -maxOutput;
+	return out;
+}
+/** Current I term contribution to the output. */
+float PIDController::GetIntegral(){
+	return _integral;
+}
+
+}}
@@ -0,0 +1,184 @@
+#include "ctre/phoenix/Motion/PathFollower.h"
+#include "ctre/phoenix/DiagnosticChannel.h"
+#include <math.h>
+
+namespace CTRE { namespace Motion {
+
+static const int kNoLimitsOrigin = DiagnosticChannel::Origin("Path Follower");
+static const float kDegToRad = 3.14159265f / 180.0f;
+
+PathFollower::PathFollower(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Drive::Styles::Smart selectedStyle,
+		const PathPoint *path, int pointCount, float maxVelocity, float trackWidth)
+{
+	_pidgey = pigeonImu;
+	_driveTrain = driveTrain;
+	_selectedStyle = selectedStyle;
+
+	_path = path;
+	_pointCount = pointCount;
+
+	_maxVelocity = maxVelocity;
+	_trackWidth = trackWidth;
+}
+void PathFollower::SetPath(const PathPoint *path, int pointCount){
+	_path = path;
+	_pointCount = pointCount;
+	_segment = 0;
+}
+/**
+ * @param b	Convergence gain, larger values correct position error more aggressively.
+ * @param zeta	Damping ratio, typically between 0.5 and 1.0.
+ */
+void PathFollower::SetGains(float b, float zeta){
+	_b = b;
+	_zeta = zeta;
+}
+/**
+ * Track the reference this many seconds ahead of the current path time.
+ * Useful to cover drivetrain latency.
+ */
+void PathFollower::SetLookahead(float seconds){
+	_lookahead = seconds;
+}
+void PathFollower::SetTolerance(float positionTolerance){
+	_positionTolerance = positionTolerance;
+}
+Pose2d PathFollower::GetPose(){
+	return _pose;
+}
+int PathFollower::GetSegmentIndex(){
+	return _segment;
+}
+void PathFollower::OnStart(){
+	_isDone = false;
+	_isGood = 0;
+	_state = 0;
+	_segment = 0;
+}
+void PathFollower::OnStop(){
+	_driveTrain->Set(CTRE::Drive::Styles::Smart::PercentOutput, 0, 0);
+	_isDone = true;
+}
+bool PathFollower::IsDone(){
+	return _isDone;
+}
+void PathFollower::OnLoop(){
+	if (_path == nullptr || _pointCount < 1) {
+		_isDone = true;
+		return;
+	}
+	switch (_state)
+	{
+		case 0: /* Init, start from the first path point */
+			_driveTrain->SetPosition(0.0f);
+			_pidgey->SetYaw(_path[0].heading);
+			_pose.x = _path[0].x;
+			_pose.y = _path[0].y;
+			_pose.heading = _path[0].heading;
+			_previousDistance = 0;
+			_pathTimer.Start();
+			_state = 1;
+			break;
+		case 1: /* Process */
+			float t = _pathTimer.Duration();
+			bool running = Follow(t);
+
+			if (running == true)
+				_isGood = 0;
+			else if (_isGood < 10)
+				++_isGood;
+			else
+			{
+				_driveTrain->Set(CTRE::Drive::Styles::Smart::PercentOutput, 0, 0);
+				_isDone = true;
+			}
+			break;
+	}
+}
+void PathFollower::Sample(float t, PathPoint & reference, float & angularRate){
+	/* Only ever walk forward, time never goes backwards within a run */
+	while (_segment < _pointCount - 2 && _path[_segment + 1].t <= t)
+		++_segment;
+
+	const PathPoint & p0 = _path[_segment];
+	if (_pointCount < 2) {
+		reference = p0;
+		angularRate = 0;
+		return;
+	}
+	const PathPoint & p1 = _path[_segment + 1];
+
+	float dt = p1.t - p0.t;
+	float dHeading = (float)Pose2d::WrapDegrees(p1.heading - p0.heading);
+	float frac = (dt > 0) ? (t - p0.t) / dt : 1.0f;
+	if (frac < 0) frac = 0;
+	if (frac > 1) frac = 1;
+
+	reference.t = t;
+	reference.x = p0.x + (p1.x - p0.x) * frac;
+	reference.y = p0.y + (p1.y - p0.y) * frac;
+	reference.heading = p0.heading + dHeading * frac;
+	reference.velocity = p0.velocity + (p1.velocity - p0.velocity) * frac;
+	angularRate = (dt > 0 && t <= p1.t) ? dHeading / dt : 0;
+}
+bool PathFollower::Follow(float t){
+	if (_maxVelocity <= 0 || _trackWidth <= 0)
+		DiagnosticChannel::SendError(GeneralWarning, kNoLimitsOrigin, "CTR: Path Follower has no max velocity or track width, cannot follow path");
+
+	/* Grab Pigeon IMU status */
+	bool angleIsGood = (_pidgey->GetState() == CTRE::PigeonIMU::PigeonState::Ready) ? true : false;
+	if (angleIsGood == false)
+	{
+		_driveTrain->Set(CTRE::Drive::Styles::Smart::PercentOutput, 0, 0);
+		return false;
+	}
+
+	/* Dead-reckon the pose from the distance travelled since last loop */
+	double YPR[3];
+	_pidgey->GetYawPitchRoll(YPR);
+	float currentDistance = _driveTrain->GetDistance();
+	_pose.Integrate(currentDistance - _previousDistance, 0, YPR[0]);
+	_previousDistance = currentDistance;
+
+	PathPoint ref;
+	float refRateDeg;
+	Sample(t + _lookahead, ref, refRateDeg);
+
+	/* Error in the robot frame */
+	float theta = (float)_pose.heading * kDegToRad;
+	float ex = (float)(ref.x - _pose.x);
+	float ey = (float)(ref.y - _pose.y);
+	float errForward = cosf(theta) * ex + sinf(theta) * ey;
+	float errLeft = -sinf(theta) * ex + cosf(theta) * ey;
+	float errHeading = (float)Pose2d::WrapDegrees(ref.heading - _pose.heading) * kDegToRad;
+
+	/* Ramsete */
+	float vRef = ref.velocity;
+	float wRef = refRateDeg * kDegToRad;
+	float k = 2.0f * _zeta * sqrtf(wRef * wRef + _b * vRef * vRef);
+	float sinc = (fabsf(errHeading) < 1e-4f) ? 1.0f - errHeading * errHeading / 6.0f : sinf(errHeading) / errHeading;
+	float v = vRef * cosf(errHeading) + k * errForward;
+	float w = wRef + k * errHeading + _b * vRef * sinc * errLeft;
+
+	/* Convert to drivetrain forward/turn, positive turn is clockwise */
+	float forward = v;
+	float turn = -w * _trackWidth * 0.5f;
+	if (_selectedStyle != CTRE::Drive::Styles::Smart::VelocityClosedLoop && _maxVelocity > 0)
+	{
+		forward /= _maxVelocity;
+		turn /= _maxVelocity;
+		forward = fmax(-1.0f, fmin(forward, 1.0f));
+		turn = fmax(-1.0f, fmin(turn, 1.0f));
+	}
+	_driveTrain->Set(_selectedStyle, forward, turn);
+
+	/* Keep running until the path time has elapsed and we are on the final point */
+	float positionError = sqrtf(ex * ex + ey * ey);
+	if (t < _path[_pointCount - 1].t)
+		return true;
+	if (_positionTolerance > 0 && positionError >= _positionTolerance)
+		return true;
+	return false;
+}
+
+}}
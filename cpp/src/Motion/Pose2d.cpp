@@ -0,0 +1,42 @@
+#include "ctre/phoenix/Motion/Pose2d.h"
+#include <math.h>
+
+namespace CTRE { namespace Motion {
+
+static const double kDegToRad = 3.14159265358979323846 / 180.0;
+
+void Pose2d::Integrate(double forward, double strafe, double newHeading){
+	double theta0 = heading * kDegToRad;
+	double dTheta = WrapDegrees(newHeading - heading) * kDegToRad;
+
+	/* Robot-frame displacement over a constant-curvature arc.
+	 * Fall back to the Taylor series when the turn is tiny to avoid 0/0. */
+	double s, c;
+	if (fabs(dTheta) < 1e-6) {
+		s = 1.0 - dTheta * dTheta / 6.0;
+		c = 0.5 * dTheta;
+	} else {
+		s = sin(dTheta) / dTheta;
+		c = (1.0 - cos(dTheta)) / dTheta;
+	}
+	double dx = forward * s - strafe * c;
+	double dy = forward * c + strafe * s;
+
+	/* Rotate into the field frame */
+	double cosT = cos(theta0);
+	double sinT = sin(theta0);
+	x += dx * cosT - dy * sinT;
+	y += dx * sinT + dy * cosT;
+	heading = newHeading;
+}
+
+double Pose2d::WrapDegrees(double angleDeg){
+	angleDeg = fmod(angleDeg, 360.0);
+	if (angleDeg > 180.0)
+		angleDeg -= 360.0;
+	else if (angleDeg <= -180.0)
+		angleDeg += 360.0;
+	return angleDeg;
+}
+
+}}
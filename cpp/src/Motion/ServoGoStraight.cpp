@@ -1,9 +1,11 @@
 #include "ctre/phoenix/Motion/ServoGoStraight.h"
-#include "HAL/DriverStation.h"
+#include "ctre/phoenix/DiagnosticChannel.h"
 #include <math.h>
 
 namespace CTRE { namespace Motion {
 
+static const int kNoGainsOrigin = DiagnosticChannel::Origin("Servo Go Straight");
+
 ServoGoStraight::ServoGoStraight(CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Drive::Styles::Smart selectedStyle,
 			ServoParameters *params, float Y, float targetHeading, float headingTolerance, float maxOutput)
 {
@@ -14,9 +16,7 @@ ServoGoStraight::ServoGoStraight(CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE
     _targetHeading = targetHeading;
     _headingTolerance = headingTolerance;
 
-    servoParameters->P = params->P;
-    servoParameters->I = params->I;
-    servoParameters->D = params->D;
+    *servoParameters = *params;
 
     _maxOutput = maxOutput;
 }
@@ -34,6 +34,8 @@ float ServoGoStraight::GetEncoderHeading(){
 void ServoGoStraight::OnStart(){
     _isDone = false;
     _state = 0;
+    _myStopWatch->Start();
+    _headingPID.Reset();
 }
 void ServoGoStraight::OnStop(){
     _driveTrain->Set(CTRE::Drive::Styles::Smart::PercentOutput, 0, 0);
@@ -56,19 +58,16 @@ void ServoGoStraight::OnLoop(){
 }
 bool ServoGoStraight::GoStraight(float Y, float targetHeading, float headingTolerance){
 	if (servoParameters->P == 0 && servoParameters->I == 0 && servoParameters->D == 0)
-		HAL_SendError(false, 1, false, "CTR: Servo Go Straight has no PID values, cannot go straight", "", "", true);
+		DiagnosticChannel::SendError(GeneralWarning, kNoGainsOrigin, "CTR: Servo Go Straight has no PID values, cannot go straight");
 	/* Grab encoder heading */
 	float currentHeading = GetEncoderHeading();
 
-	/* Find angular rate from the encoders */
-	_timeElapsed = _myStopWatch->Duration();
-	float correctionRate = ((currentHeading - _previousHeading) / _timeElapsed);
-	_myStopWatch->Start();
+	/* Angular rate is taken from the encoder heading over the elapsed time */
+	_timeElapsed = _myStopWatch->Lap();
 
 	/* Heading PID */
 	float headingError = targetHeading - currentHeading;
-	float X = (headingError) * servoParameters->P - (correctionRate) * servoParameters->D;
-	X = fmax(-_maxOutput, fmin(X, _maxOutput));
+	float X = _headingPID.Calculate(*servoParameters, targetHeading, currentHeading, _timeElapsed, _maxOutput);
 	X = -X;
 
 	/* Select control mode based on selected style */
@@ -87,7 +86,6 @@ bool ServoGoStraight::GoStraight(float Y, float targetHeading, float headingTole
 		_driveTrain->Set(CTRE::Drive::Styles::Smart::VelocityClosedLoop, Y, X);
 		break;
 	}
-	_previousHeading = currentHeading;
 
 	if (fabs(headingError) >= headingTolerance)
 	{
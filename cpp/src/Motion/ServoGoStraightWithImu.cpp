@@ -1,27 +1,29 @@
 #include "ctre/phoenix/Motion/ServoGoStraightWithIMU.h"
-#include "HAL/DriverStation.h"
+#include "ctre/phoenix/DiagnosticChannel.h"
 #include <math.h>
 
 namespace CTRE { namespace Motion {
 
+static const int kNoGainsOrigin = DiagnosticChannel::Origin("Servo Go Straight With Imu");
+
 ServoGoStraightWithImu::ServoGoStraightWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::IDrivetrain *driveTrain, CTRE::Drive::Styles::Basic selectedStyle,
 		ServoParameters *parameters, float Y, float targetHeading, float headingTolerance, float maxOutput)
 {
 	_pidgey = pigeonImu;
+	_imu = CTRE::CachedPigeon(pigeonImu);
 	_driveTrain = driveTrain;
 	_selectedStyle = selectedStyle;
 	_Y = Y;
 	_targetHeading = targetHeading;
 	_headingTolerance = headingTolerance;
 
-	servoParameters->P = parameters->P;
-    servoParameters->I = parameters->I;
-    servoParameters->D = parameters->D;
+	*servoParameters = *parameters;
 
 	_maxOutput = maxOutput;
 }
 ServoGoStraightWithImu::ServoGoStraightWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::IDrivetrain *driveTrain, CTRE::Drive::Styles::Basic selectedStyle){
 	_pidgey = pigeonImu;
+	_imu = CTRE::CachedPigeon(pigeonImu);
 	_driveTrain = driveTrain;
 	_selectedStyle = selectedStyle;
 }
@@ -31,12 +33,20 @@ bool ServoGoStraightWithImu::Set(float Y, float targetHeading, float headingTole
 }
 float ServoGoStraightWithImu::GetImuHeading(){
 	double YPR[3];
-	_pidgey->GetYawPitchRoll(YPR);
+	_imu.GetYawPitchRoll(YPR);
 	return (float)YPR[0];
 }
+/**
+ * Read the Pigeon from this per-tick cache, nullptr to read it directly.
+ */
+void ServoGoStraightWithImu::SetDeviceCache(CTRE::DeviceCache *cache){
+	_imu.Attach(cache);
+}
 void ServoGoStraightWithImu::OnStart(){
 	_isDone = false;
 	_state = 0;
+	_myStopwatch.Start();
+	_headingPID.Reset();
 }
 void ServoGoStraightWithImu::OnStop(){
 	_driveTrain->Set(CTRE::Drive::Styles::Basic::PercentOutputBasic, 0, 0);
@@ -59,25 +69,24 @@ void ServoGoStraightWithImu::OnLoop(){
 }
 bool ServoGoStraightWithImu::GoStraight(float Y, float targetHeading, float headingTolerance){
 	if (servoParameters->P == 0 && servoParameters->I == 0 && servoParameters->D == 0)
-		HAL_SendError(false, 1, false, "CTR: Servo Go Straight With Imu has no PID values, cannot go straight", "", "", true);
+		DiagnosticChannel::SendError(GeneralWarning, kNoGainsOrigin, "CTR: Servo Go Straight With Imu has no PID values, cannot go straight");
 	/* Grab current heading */
 	float currentHeading = GetImuHeading();
 
 	/* Grab angular rate from the pigeon */
 	double XYZ_Dps[3];
-	_pidgey->GetRawGyro(XYZ_Dps);
+	_imu.GetRawGyro(XYZ_Dps);
 	float currentAngularRate = (float)XYZ_Dps[2];
 
 	/* Grab Pigeon IMU status */
-	bool angleIsGood = (_pidgey->GetState() == CTRE::PigeonIMU::PigeonState::Ready) ? true : false;
+	bool angleIsGood = (_imu.GetState() == CTRE::PigeonIMU::PigeonState::Ready) ? true : false;
 
 	/* Runs GoStraight if Pigeon IMU is present and in good health, else stop drivetrain */
 	if (angleIsGood == true)
 	{
 		/* Heading PID */
 		float headingError = targetHeading - currentHeading;
-		float X = (headingError) * servoParameters->P - (currentAngularRate) * servoParameters->D;
-		X = fmax(-_maxOutput, fmin(X, _maxOutput));
+		float X = _headingPID.Calculate(*servoParameters, targetHeading, currentHeading, currentAngularRate, _myStopwatch.Lap(), _maxOutput);
 		X = -X;
 
 		/* Select control mode based on selected style */
@@ -1,14 +1,17 @@
 #include "ctre/phoenix/Motion/ServoGoStraightWithImuSmart.h"
-#include "HAL/DriverStation.h"
+#include "ctre/phoenix/DiagnosticChannel.h"
 #include <math.h>
 
 
 namespace CTRE { namespace Motion {
 
+static const int kNoGainsOrigin = DiagnosticChannel::Origin("Servo Go Straight With Imu Smart");
+
 ServoGoStraightWithImuSmart::ServoGoStraightWithImuSmart(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Drive::Styles::Smart selectedStyle,
 		ServoParameters *straightParameters, float Y, float targetHeading, float headingTolerance, float maxOutput)
 {
     _pidgey = pigeonImu;
+    _imu = CTRE::CachedPigeon(pigeonImu);
     _driveTrain = driveTrain;
     _selectedStyle = selectedStyle;
 
@@ -17,14 +20,13 @@ ServoGoStraightWithImuSmart::ServoGoStraightWithImuSmart(CTRE::PigeonIMU *pigeon
     _targetHeading = targetHeading;
     _headingTolerance = headingTolerance;
 
-    servoParameters->P = straightParameters->P;
-    servoParameters->I = straightParameters->I;
-    servoParameters->D = straightParameters->D;
+    *servoParameters = *straightParameters;
 
     _maxOutput = maxOutput;
 }
 ServoGoStraightWithImuSmart::ServoGoStraightWithImuSmart(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Drive::Styles::Smart selectedStyle){
     _pidgey = pigeonImu;
+    _imu = CTRE::CachedPigeon(pigeonImu);
     _driveTrain = driveTrain;
     _selectedStyle = selectedStyle;
 }
@@ -34,12 +36,20 @@ bool ServoGoStraightWithImuSmart::Set(float Y, float targetHeading, float headin
 }
 float ServoGoStraightWithImuSmart::GetImuHeading(){
 	double YPR[3];
-	_pidgey->GetYawPitchRoll(YPR);
+	_imu.GetYawPitchRoll(YPR);
 	return (float)YPR[0];
 }
+/**
+ * Read the Pigeon from this per-tick cache, nullptr to read it directly.
+ */
+void ServoGoStraightWithImuSmart::SetDeviceCache(CTRE::DeviceCache *cache){
+	_imu.Attach(cache);
+}
 void ServoGoStraightWithImuSmart::OnStart(){
 	_isDone = false;
 	_state = 0;
+	_myStopwatch.Start();
+	_headingPID.Reset();
 }
 void ServoGoStraightWithImuSmart::OnStop(){
     _driveTrain->Set(CTRE::Drive::Styles::Smart::PercentOutput, 0, 0);
@@ -62,26 +72,25 @@ void ServoGoStraightWithImuSmart::OnLoop(){
 }
 bool ServoGoStraightWithImuSmart::GoStraight(float Y, float targetHeading, float headingTolerance){
 	if (servoParameters->P == 0 && servoParameters->I == 0 && servoParameters->D == 0)
-		HAL_SendError(false, 1, false, "CTR: Servo Go Straight With Imu Smart has no PID values, cannot go straight", "", "", true);
+		DiagnosticChannel::SendError(GeneralWarning, kNoGainsOrigin, "CTR: Servo Go Straight With Imu Smart has no PID values, cannot go straight");
 	/* Grab current heading */
 	float currentHeading = GetImuHeading();
 
 	/* Grab angular rate from the pigeon */
 	double XYZ_Dps[3];
-	_pidgey->GetRawGyro(XYZ_Dps);
+	_imu.GetRawGyro(XYZ_Dps);
 	float currentAngularRate = (float)XYZ_Dps[2];
 
 	/* Grab Pigeon IMU status */
-	bool angleIsGood = (_pidgey->GetState() == CTRE::PigeonIMU::PigeonState::Ready) ? true : false;
+	bool angleIsGood = (_imu.GetState() == CTRE::PigeonIMU::PigeonState::Ready) ? true : false;
 
 	/* Runs GoStraight if Pigeon IMU is present and in good health, else stop drivetrain */
 	if (angleIsGood == true)
 	{
 		/* Heading PID */
 		float headingError = targetHeading - currentHeading;
-		float X = (headingError) * servoParameters->P - (currentAngularRate) * servoParameters->D;
+		float X = _headingPID.Calculate(*servoParameters, targetHeading, currentHeading, currentAngularRate, _myStopwatch.Lap(), _maxOutput);
 		X = -X;
-		X = fmax(-_maxOutput, fmin(X, _maxOutput));
 
 		/* Select control mode based on selected style */
 		switch (_selectedStyle)
@@ -1,10 +1,13 @@
 #include "ctre/phoenix/Motion/ServoStraightDistance.h"
-#include "HAL/DriverStation.h"
+#include "ctre/phoenix/DiagnosticChannel.h"
 #include <math.h>
 
 
 namespace CTRE { namespace Motion {
 
+static const int kNoStraightGainsOrigin = DiagnosticChannel::Origin("Servo Straight Distance straight gains");
+static const int kNoDistanceGainsOrigin = DiagnosticChannel::Origin("Servo Straight Distance distance gains");
+
 ServoStraightDistance::ServoStraightDistance(CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Drive::Styles::Smart selectedStyle, ServoParameters *turnParams,
 		ServoParameters *distanceParams, float targetHeading, float targetDistance, float headingTolerance, float distanceTolerance, float maxOutput)
 {
@@ -25,17 +28,9 @@ ServoStraightDistance::ServoStraightDistance(CTRE::Drive::ISmartDrivetrain *driv
 	_headingTolerance = headingTolerance;
 	_distanceTolerance = distanceTolerance;
 
-	distanceServoParameters->P = distanceParams->P;
-	distanceServoParameters->I = distanceParams->I;
-	distanceServoParameters->D = distanceParams->D;
-
-	straightServoParameters->P = turnParams->P;
-	straightServoParameters->I = turnParams->I;
-	straightServoParameters->D = turnParams->D;
-
-	StraightDrive->servoParameters->P = turnParams->P;
-	StraightDrive->servoParameters->I = turnParams->I;
-	StraightDrive->servoParameters->D = turnParams->D;
+	*distanceServoParameters = *distanceParams;
+	*straightServoParameters = *turnParams;
+	*StraightDrive->servoParameters = *turnParams;
 
 	_maxOutput = maxOutput;
 }
@@ -52,9 +47,7 @@ ServoStraightDistance::ServoStraightDistance(CTRE::Drive::ISmartDrivetrain *driv
         StraightDrive = new ServoGoStraight(_driveTrain, CTRE::Drive::Styles::Smart::VelocityClosedLoop);
 }
 bool ServoStraightDistance::Set(float targetHeading, float targetDistance, float headingTolerance, float distanceTolerance, float maxOutput){
-	StraightDrive->servoParameters->P = straightServoParameters->P;
-	StraightDrive->servoParameters->I = straightServoParameters->I;
-	StraightDrive->servoParameters->D = straightServoParameters->D;
+	*StraightDrive->servoParameters = *straightServoParameters;
 
     _maxOutput = maxOutput;
 
@@ -70,6 +63,8 @@ void ServoStraightDistance::OnStart(){
     _isDone = false;
     _isGood = 0;
     _state = 0;
+    _myStopWatch->Start();
+    _distancePID.Reset();
 }
 void ServoStraightDistance::OnStop(){
     _driveTrain->Set(CTRE::Drive::Styles::Smart::PercentOutput, 0, 0);
@@ -103,21 +98,18 @@ void ServoStraightDistance::OnLoop(){
 }
 bool ServoStraightDistance::StraightDistance(float targetHeading, float targetDistance, float headingTolerance, float distanceTolerance){
     if (straightServoParameters->P == 0 && straightServoParameters->I == 0 && straightServoParameters->D == 0)
-    	HAL_SendError(false, 1, false, "CTR: Servo Straight Distance has no straight PID values, cannot go straight", "", "", true);
+    	DiagnosticChannel::SendError(GeneralWarning, kNoStraightGainsOrigin, "CTR: Servo Straight Distance has no straight PID values, cannot go straight");
     if (distanceServoParameters->P == 0 && distanceServoParameters->I == 0 && distanceServoParameters->D == 0)
-    	HAL_SendError(false, 1, false, "CTR: Servo Straight Distance has no distance PID values, cannot go forward", "", "", true);
+    	DiagnosticChannel::SendError(GeneralWarning, kNoDistanceGainsOrigin, "CTR: Servo Straight Distance has no distance PID values, cannot go forward");
     /* Grab current heading and distance*/
     float currentDistance = GetEncoderDistance();
 
-    /* Find the error between the target and current value */
-    _timeElapsed = _myStopWatch->Duration();
-    float distanceRate = ((currentDistance - _previousDistance) / (_timeElapsed));
-    _myStopWatch->Start();
+    /* Elapsed time since the last distance sample */
+    _timeElapsed = _myStopWatch->Lap();
 
     /* Distance PID */
     float distanceError = targetDistance - currentDistance;
-    float Y = (distanceError) * distanceServoParameters->P - (distanceRate) * distanceServoParameters->D;
-    Y = fmax(-_maxOutput, fmin(Y, _maxOutput));
+    float Y = _distancePID.Calculate(*distanceServoParameters, targetDistance, currentDistance, _timeElapsed, _maxOutput);
 
     /* StraightDrive moded selected when created within constructor */
     if (_selectedStyle == CTRE::Drive::Styles::Smart::Voltage)
@@ -127,8 +119,6 @@ bool ServoStraightDistance::StraightDistance(float targetHeading, float targetDi
     }
     bool headingCheck = StraightDrive->Set(Y, targetHeading, headingTolerance, _maxOutput);
 
-    _previousDistance = currentDistance;
-
     if ((fabs(distanceError) >= distanceTolerance) || (headingCheck == true))
     {
         _isRunning = true;
@@ -1,13 +1,17 @@
 #include "ctre/phoenix/Motion/ServoStraightDistanceWithIMU.h"
-#include "HAL/DriverStation.h"
+#include "ctre/phoenix/DiagnosticChannel.h"
 #include <math.h>
 
 namespace CTRE { namespace Motion {
 
+static const int kNoStraightGainsOrigin = DiagnosticChannel::Origin("Servo Straight Distance With Imu straight gains");
+static const int kNoDistanceGainsOrigin = DiagnosticChannel::Origin("Servo Straight Distance With Imu distance gains");
+
 ServoStraightDistanceWithImu::ServoStraightDistanceWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::ISmartDrivetrain *drivetrain, CTRE::Drive::Styles::Smart selectedStyle, ServoParameters *straightParameters,
 		ServoParameters *distanceParameters, float targetHeading, float targetDistance, float headingTolerance, float distanceTolerance, float maxOutput)
 {
     _pidgey = pigeonImu;
+    _imu = CTRE::CachedPigeon(pigeonImu);
     _driveTrain = drivetrain;
     _selectedStyle = selectedStyle;
 
@@ -25,22 +29,15 @@ ServoStraightDistanceWithImu::ServoStraightDistanceWithImu(CTRE::PigeonIMU *pige
     _headingTolerance = headingTolerance;
     _distanceTolerance = distanceTolerance;
 
-    distanceServoParameters->P = distanceParameters->P;
-    distanceServoParameters->I = distanceParameters->I;
-    distanceServoParameters->D = distanceParameters->D;
-
-    straightServoParameters->P = straightParameters->P;
-    straightServoParameters->I = straightParameters->I;
-    straightServoParameters->D = straightParameters->D;
-
-    StraightDrive->servoParameters->P = straightParameters->P;
-    StraightDrive->servoParameters->I = straightParameters->I;
-    StraightDrive->servoParameters->D = straightParameters->D;
+    *distanceServoParameters = *distanceParameters;
+    *straightServoParameters = *straightParameters;
+    *StraightDrive->servoParameters = *straightParameters;
 
     _maxOutput = maxOutput;
 }
 ServoStraightDistanceWithImu::ServoStraightDistanceWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::ISmartDrivetrain *drivetrain, CTRE::Drive::Styles::Smart selectedStyle){
     _pidgey = pigeonImu;
+    _imu = CTRE::CachedPigeon(pigeonImu);
     _driveTrain = drivetrain;
     _selectedStyle = selectedStyle;
 
@@ -53,9 +50,7 @@ ServoStraightDistanceWithImu::ServoStraightDistanceWithImu(CTRE::PigeonIMU *pige
         StraightDrive = new ServoGoStraightWithImuSmart(_pidgey, _driveTrain, CTRE::Drive::Styles::Smart::VelocityClosedLoop);
 }
 bool ServoStraightDistanceWithImu::Set(float targetHeading, float targetDistance, float headingTolerance, float distanceTolerance, float maxOutput){
-	StraightDrive->servoParameters->P = straightServoParameters->P;
-	StraightDrive->servoParameters->I = straightServoParameters->I;
-	StraightDrive->servoParameters->D = straightServoParameters->D;
+	*StraightDrive->servoParameters = *straightServoParameters;
 
     _maxOutput = maxOutput;
 
@@ -63,9 +58,17 @@ bool ServoStraightDistanceWithImu::Set(float targetHeading, float targetDistance
 }
 float ServoStraightDistanceWithImu::GetImuHeading(){
     double YPR[3];
-    _pidgey->GetYawPitchRoll(YPR);
+    _imu.GetYawPitchRoll(YPR);
     return (float)YPR[0];
 }
+/**
+ * Read the Pigeon from this per-tick cache, nullptr to read it directly.
+ * The inner straight drive does the per-tick heading reads, so it shares the cache.
+ */
+void ServoStraightDistanceWithImu::SetDeviceCache(CTRE::DeviceCache *cache){
+    _imu.Attach(cache);
+    StraightDrive->SetDeviceCache(cache);
+}
 float ServoStraightDistanceWithImu::GetEncoderDistance(){
     return _driveTrain->GetDistance();
 }
@@ -73,6 +76,8 @@ void ServoStraightDistanceWithImu::OnStart(){
     _isDone = false;
     _isGood = 0;
     _state = 0;
+    _myStopWatch->Start();
+    _distancePID.Reset();
 }
 void ServoStraightDistanceWithImu::OnStop(){
     _driveTrain->Set(CTRE::Drive::Styles::Smart::PercentOutput, 0, 0);
@@ -107,21 +112,18 @@ void ServoStraightDistanceWithImu::OnLoop(){
 }
 bool ServoStraightDistanceWithImu::StraightDistance(float targetHeading, float targetDistance, float headingTolerance, float distanceTolerance){
     if (straightServoParameters->P == 0 && straightServoParameters->I == 0 && straightServoParameters->D == 0)
-    	HAL_SendError(false, 1, false, "CTR: Servo Straight Distance With Imu has no straight PID values, cannot go straight", "", "", true);
+    	DiagnosticChannel::SendError(GeneralWarning, kNoStraightGainsOrigin, "CTR: Servo Straight Distance With Imu has no straight PID values, cannot go straight");
     if (distanceServoParameters->P == 0 && distanceServoParameters->I == 0 && distanceServoParameters->D == 0)
-    	HAL_SendError(false, 1, false, "CTR: Servo Straight Distance With Imuhas no distance PID values, cannot go forward", "", "", true);
+    	DiagnosticChannel::SendError(GeneralWarning, kNoDistanceGainsOrigin, "CTR: Servo Straight Distance With Imu has no distance PID values, cannot go forward");
     /* Grab current distance */
     float currentDistance = GetEncoderDistance();
 
-    /* Grab the positionRate and elapsed time, must be done anytime we use D gain */
-    _timeElapsed = (_myStopWatch->Duration());
-    float positionRate = ((currentDistance - _previousDistance) / (_timeElapsed));
-    _myStopWatch->Start();
+    /* Grab the elapsed time, must be done anytime we use I or D gain */
+    _timeElapsed = _myStopWatch->Lap();
 
     /* Distance PID */
     float distanceError = targetDistance - currentDistance;
-    float Y = (distanceError) * distanceServoParameters->P - (positionRate) * distanceServoParameters->D;   //We want to PID object here
-    Y = fmax(-_maxOutput, fmin(Y, _maxOutput));
+    float Y = _distancePID.Calculate(*distanceServoParameters, targetDistance, currentDistance, _timeElapsed, _maxOutput);
 
     /* StraightDrive moded selected when created within constructor */
     if (_selectedStyle == CTRE::Drive::Styles::Smart::Voltage)
@@ -131,8 +133,6 @@ bool ServoStraightDistanceWithImu::StraightDistance(float targetHeading, float t
     }
     bool headingCheck = StraightDrive->Set(Y, targetHeading, headingTolerance, _maxOutput);
 
-    _previousDistance = currentDistance;
-
     if ((fabs(distanceError) >= distanceTolerance) || (headingCheck == true))
     {
         _isRunning = true;
@@ -1,9 +1,11 @@
 #include "ctre/phoenix/Motion/ServoZeroTurn.h"
-#include "HAL/DriverStation.h"
+#include "ctre/phoenix/DiagnosticChannel.h"
 #include <math.h>
 
 namespace CTRE { namespace Motion {
 
+static const int kNoGainsOrigin = DiagnosticChannel::Origin("Servo Zero Turn");
+
 ServoZeroTurn::ServoZeroTurn(CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Drive::Styles::Smart smartStyle,
 		float targetHeading, float headingTolerance, ServoParameters *Params, float maxOutput)
 {
@@ -15,9 +17,7 @@ ServoZeroTurn::ServoZeroTurn(CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Dr
 
     _maxOutput = maxOutput;
 
-    servoParams->P = Params->P;
-    servoParams->I = Params->I;
-    servoParams->D = Params->D;
+    *servoParams = *Params;
 }
 ServoZeroTurn::ServoZeroTurn(CTRE::Drive::ISmartDrivetrain *driveTrain, CTRE::Drive::Styles::Smart smartStyle){
     _driveTrain = driveTrain;
@@ -34,6 +34,8 @@ void ServoZeroTurn::OnStart(){
     _isDone = false;
     _isGood = 0;
     _state = 0;
+    _myStopwatch->Start();
+    _headingPID.Reset();
 }
 void ServoZeroTurn::OnStop(){
     _driveTrain->Set(CTRE::Drive::Styles::Smart::PercentOutput, 0, 0);
@@ -66,20 +68,17 @@ void ServoZeroTurn::OnLoop(){
 }
 bool ServoZeroTurn::ZeroTurn(float targetHeading, float headingTolerance){
     if (servoParams->P == 0 && servoParams->I == 0 && servoParams->D == 0)
-    	HAL_SendError(true, 1, false, "CTR: Servo Zero Turn has no PID values, cannot turn", "", "", true);
+    	DiagnosticChannel::SendError(GeneralError, kNoGainsOrigin, "CTR: Servo Zero Turn has no PID values, cannot turn");
     /* Grab the current heading*/
     float currentHeading = GetEncoderHeading();
 
-    /* Find the difference between last heading and current heading */
-    _timeElapsed = _myStopwatch->Duration();
-    float headingRate = currentHeading - _previousHeading;
-    _myStopwatch->Start();
+    /* Elapsed time since the last heading sample */
+    _timeElapsed = _myStopwatch->Lap();
 
     /* Heading PID */
     float headingError = targetHeading - currentHeading;
-    float X = ((headingError) * servoParams->P) - ((headingRate) * servoParams->D);
+    float X = _headingPID.Calculate(*servoParams, targetHeading, currentHeading, _timeElapsed, _maxOutput);
     X = -X;
-    X = fmax(-_maxOutput, fmin(X, _maxOutput));
 
 
     /** Set the output of the drivetrain */
@@ -97,9 +96,6 @@ bool ServoZeroTurn::ZeroTurn(float targetHeading, float headingTolerance){
             break;
     }
 
-    /** Grab the heading to compare next time */
-    _previousHeading = currentHeading;
-
     if (fabs(headingError) >= headingTolerance )
     {
         _isRunning = true;
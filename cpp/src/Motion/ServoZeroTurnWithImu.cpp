@@ -1,14 +1,17 @@
 #include "ctre/phoenix/Motion/ServoZeroTurnWithIMU.h"
-#include "HAL/DriverStation.h"
+#include "ctre/phoenix/DiagnosticChannel.h"
 #include <math.h>
 
 namespace CTRE { namespace Motion {
 
+static const int kNoGainsOrigin = DiagnosticChannel::Origin("Servo Zero Turn With Imu");
+
 ServoZeroTurnWithImu::ServoZeroTurnWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::IDrivetrain *driveTrain,
 		CTRE::Drive::Styles::Basic selectedStyle, float targetHeading, float headingTolerance,
 		ServoParameters *Params, float maxOutput)
 {
     _pidgey = pigeonImu;
+    _imu = CTRE::CachedPigeon(pigeonImu);
     _driveTrain = driveTrain;
     _selectedStyle = selectedStyle;
 
@@ -17,13 +20,12 @@ ServoZeroTurnWithImu::ServoZeroTurnWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Dri
 
     _maxOutput = maxOutput;
 
-    servoParams->P = Params->P;
-    servoParams->I = Params->I;
-    servoParams->D = Params->D;
+    *servoParams = *Params;
 }
 ServoZeroTurnWithImu::ServoZeroTurnWithImu(CTRE::PigeonIMU *pigeonImu, CTRE::Drive::IDrivetrain *driveTrain, CTRE::Drive::Styles::Basic selectedStyle){
     _selectedStyle = selectedStyle;
     _pidgey = pigeonImu;
+    _imu = CTRE::CachedPigeon(pigeonImu);
     _driveTrain = driveTrain;
 }
 bool ServoZeroTurnWithImu::Set(float targetHeading, float headingTolerance, float maxOutput){
@@ -32,13 +34,21 @@ bool ServoZeroTurnWithImu::Set(float targetHeading, float headingTolerance, floa
 }
 float ServoZeroTurnWithImu::GetImuHeading(){
     double YPR[3];
-    _pidgey->GetYawPitchRoll(YPR);
+    _imu.GetYawPitchRoll(YPR);
     return (float)YPR[0];
 }
+/**
+ * Read the Pigeon from this per-tick cache, nullptr to read it directly.
+ */
+void ServoZeroTurnWithImu::SetDeviceCache(CTRE::DeviceCache *cache){
+    _imu.Attach(cache);
+}
 void ServoZeroTurnWithImu::OnStart(){
     _isDone = false;
     _isGood = 0;
     _state = 0;
+    _myStopwatch.Start();
+    _headingPID.Reset();
 }
 void ServoZeroTurnWithImu::OnStop(){
     _driveTrain->Set(CTRE::Drive::Styles::Basic::PercentOutputBasic, 0, 0);
@@ -71,26 +81,25 @@ void ServoZeroTurnWithImu::OnLoop(){
 }
 bool ServoZeroTurnWithImu::ZeroTurn(float targetHeading, float headingTolerance){
     if (servoParams->P == 0 && servoParams->I == 0 && servoParams->D == 0)
-    	HAL_SendError(false, 1, false, "CTR: Servo Zero Turn With Imu has no PID values, cannot turn", "", "", true);
+    	DiagnosticChannel::SendError(GeneralWarning, kNoGainsOrigin, "CTR: Servo Zero Turn With Imu has no PID values, cannot turn");
     /* Grab the current heading */
     float currentHeading = GetImuHeading();
 
     /* Grab angular rate from the pigeon */
     double XYZ_Dps[3];
-    _pidgey->GetRawGyro(XYZ_Dps);
+    _imu.GetRawGyro(XYZ_Dps);
     float currentAngularRate = (float)XYZ_Dps[2];
 
     /* Grab Pigeon IMU status */
-    bool angleIsGood = (_pidgey->GetState() == CTRE::PigeonIMU::PigeonState::Ready) ? true : false;
+    bool angleIsGood = (_imu.GetState() == CTRE::PigeonIMU::PigeonState::Ready) ? true : false;
 
     /* Runs ZeroTurn if Pigeon IMU is present and in good health, else do nothing */
     if (angleIsGood == true)
     {
         /* Heading PID */
         float headingError = targetHeading - currentHeading;
-        float X = (headingError) * servoParams->P - (currentAngularRate) * servoParams->D;
+        float X = _headingPID.Calculate(*servoParams, targetHeading, currentHeading, currentAngularRate, _myStopwatch.Lap(), _maxOutput);
         X = -X;
-        X = fmax(-_maxOutput, fmin(X, _maxOutput));
 
 
         /** Set the output of the drivetrain */
@@ -1,7 +1,14 @@
 ﻿#include "ctre/phoenix/MotorControl/CAN/BaseMotorController.h"
 #include "ctre/phoenix/CCI/MotController_CCI.h"
 #include "ctre/phoenix/LowLevel/MotControllerWithBuffer_LowLevel.h"
+#include "ctre/phoenix/LowLevel/CTRE_Native_CAN.h"
+#include "ctre/phoenix/MotorControl/DeviceCatalog.h"
+#include "ctre/phoenix/MotorControl/FaultBits.h"
 #include "../WpilibSpeedController.h"
+#include "ctre/phoenix/DiagnosticChannel.h"
+#include "ctre/phoenix/Telemetry/ControlLog.h"
+#include <atomic>
+#include <stdio.h>
 
 using namespace CTRE::MotorControl;
 using namespace CTRE::MotorControl::CAN;
@@ -19,13 +26,20 @@ BaseMotorController::BaseMotorController(int arbId) {
 	m_handle = c_MotController_Create1(arbId);
 	_arbId = arbId;
 
+	char origin[40];
+	snprintf(origin, sizeof(origin), "Motor Controller %08X", arbId);
+	_diagnosticOrigin = CTRE::DiagnosticChannel::Origin(origin);
+
 	_wpilibSpeedController = new CTRE::MotorControl::WpilibSpeedController(this);
 
+	DeviceCatalog::GetInstance().Register(this);
+
 	//_sensColl = new SensorCollection(_ll);
 }
 
 BaseMotorController::~BaseMotorController()
 {
+	DeviceCatalog::GetInstance().Unregister(this);
 	delete _wpilibSpeedController;
 	_wpilibSpeedController = 0;
 }
@@ -74,7 +88,7 @@ void BaseMotorController::Set(ControlMode mode, float demand0, float demand1) {
 	switch (m_controlMode) {
 		case ControlMode::PercentOutput:
 		case ControlMode::TimedPercentOutput:
-			c_MotController_SetDemand(m_handle, (int)m_sendMode, (int) (1023 * demand0), 0);
+			SendDemand((int)m_sendMode, (int) (1023 * demand0), 0);
 			break;
 		case ControlMode::Follower:
 			/* did caller specify device ID */
@@ -86,7 +100,7 @@ void BaseMotorController::Set(ControlMode mode, float demand0, float demand1) {
 			} else {
 				work = (uint32_t)demand0;
 			}
-			c_MotController_SetDemand(m_handle, (int)m_sendMode, work, 0);
+			SendDemand((int)m_sendMode, work, 0);
 			break;
 
 		case ControlMode::Velocity:
@@ -94,15 +108,15 @@ void BaseMotorController::Set(ControlMode mode, float demand0, float demand1) {
 		case ControlMode::MotionMagic:
 		case ControlMode::MotionMagicArc:
 		case ControlMode::MotionProfile:
-			c_MotController_SetDemand(m_handle, (int)m_sendMode, (int) (demand0), 0);
+			SendDemand((int)m_sendMode, (int) (demand0), 0);
 			break;
 		case ControlMode::Current:
-			c_MotController_SetDemand(m_handle, (int)m_sendMode, (int) (1000 * demand0), 0); /* milliamps */
+			SendDemand((int)m_sendMode, (int) (1000 * demand0), 0); /* milliamps */
 			break;
 		case ControlMode::Disabled:
 			/* fall thru...*/
 		default:
-			c_MotController_SetDemand(m_handle, (int)m_sendMode, 0, 0);
+			SendDemand((int)m_sendMode, 0, 0);
 			break;
 	}
 	//
@@ -133,6 +147,34 @@ void BaseMotorController::Set(ControlMode mode, float demand0, float demand1) {
 	//}
 	SetLastError(status);
 }
+/* shared by every controller, nullptr when not logging */
+static std::atomic<CTRE::Telemetry::ControlLog*> _controlLog(nullptr);
+/* shared by every controller, true while a recording is replayed */
+static std::atomic<bool> _replay(false);
+
+/**
+ * Copy every demand sent by any motor controller into log, nullptr to stop.
+ */
+void BaseMotorController::SetControlLog(CTRE::Telemetry::ControlLog *log) {
+	_controlLog.store(log, std::memory_order_release);
+}
+/**
+ * In replay demands are only copied into the ControlLog, nothing is sent to
+ * the motor controllers.  Set by TelemetryReplay::Load().
+ */
+void BaseMotorController::SetReplay(bool replay) {
+	_replay.store(replay, std::memory_order_release);
+}
+bool BaseMotorController::IsReplay() {
+	return _replay.load(std::memory_order_acquire);
+}
+void BaseMotorController::SendDemand(int mode, int demand0, int demand1) {
+	if (_replay.load(std::memory_order_acquire) == false)
+		c_MotController_SetDemand(m_handle, mode, demand0, demand1);
+	CTRE::Telemetry::ControlLog *log = _controlLog.load(std::memory_order_acquire);
+	if (log != nullptr)
+		log->Record(_arbId, mode, demand0, demand1);
+}
 void BaseMotorController::NeutralOutput() {
 	Set(ControlMode::Disabled, 0);
 }
@@ -443,23 +485,42 @@ ErrorCode BaseMotorController::GetLastError() {
 	return _lastError;
 }
 ErrorCode BaseMotorController::SetLastError(int error) {
-	_lastError = (ErrorCode) error;
-	return _lastError;
+	return SetLastError((ErrorCode) error);
 }
+/**
+ * Errors are also reported through DiagnosticChannel, so a failing call
+ * made every loop is logged at the channel's rate limit.
+ */
 ErrorCode BaseMotorController::SetLastError(ErrorCode error) {
-	_lastError = (ErrorCode) error;
+	_lastError = error;
+	if (error != OK)
+		CTRE::DiagnosticChannel::Report(error, _diagnosticOrigin);
 	return _lastError;
 }
 
 //------ Faults ----------//
+/**
+ * Decoded from the cached Status_1 frame, see FaultBits.h for the bit table.
+ */
 ErrorCode BaseMotorController::GetFaults(Faults & toFill) {
-	return ErrorCode::NotImplemented; // 	return SetLastError(_ll->GetFaults(toFill));
+	uint64_t frame = 0;
+	int len = 0;
+	int err = CTRE_Native_CAN_Receive(_arbId | FaultBits::kStatus1, frame, len, true);
+	FaultBits::Unpack(FaultBits::FromStatus1(frame), toFill);
+	return SetLastError(err);
 }
+/**
+ * Decoded from the cached Status_2 frame, see FaultBits.h for the bit table.
+ */
 ErrorCode BaseMotorController::GetStickyFaults(StickyFaults & toFill) {
-	return ErrorCode::NotImplemented; // return SetLastError(_ll->GetStickyFaults(toFill));
+	uint64_t frame = 0;
+	int len = 0;
+	int err = CTRE_Native_CAN_Receive(_arbId | FaultBits::kStatus2, frame, len, true);
+	FaultBits::Unpack(FaultBits::FromStatus2(frame), toFill);
+	return SetLastError(err);
 }
 ErrorCode BaseMotorController::ClearStickyFaults(int timeoutMs) {
-	return ErrorCode::NotImplemented; // return SetLastError(_ll->ClearStickyFaults(timeoutMs));
+	return SetLastError(c_MotController_ConfigSetParameter(m_handle, eStickyFaults, 0, 0, 0, timeoutMs));
 }
 
 //------ Firmware ----------//
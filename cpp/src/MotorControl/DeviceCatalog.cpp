@@ -1,5 +1,125 @@
 #include <ctre/phoenix/MotorControl/DeviceCatalog.h>
+#include "ctre/phoenix/DeviceCache.h"
+#include "ctre/phoenix/Sensors/PigeonIMU.h"
+#include "ctre/phoenix/CANifier.h"
+#include <algorithm>
+#include <string.h>
 
 using namespace CTRE::MotorControl;
 
-DeviceCatalog * DeviceCatalog::_instance = 0;
+/* Victor SPX base arbitration ID, see VictorSPX.cpp */
+static const uint32_t kVictorSPXBaseId = 0x01040000;
+
+DeviceCatalog & DeviceCatalog::GetInstance() {
+	/* Constructed on first use so devices created during static init can register */
+	static DeviceCatalog catalog;
+	return catalog;
+}
+DeviceCatalog::DeviceCatalog() {
+	memset(_index, 0, sizeof(_index));
+}
+void DeviceCatalog::Index(DeviceType type, int deviceId, void *device) {
+	if (deviceId < 0 || deviceId > kMaxDeviceId)
+		return;
+	/* First one wins if two objects claim the same ID */
+	if (_index[type][deviceId] == nullptr)
+		_index[type][deviceId] = device;
+}
+void DeviceCatalog::Unindex(DeviceType type, void *device) {
+	for (int i = 0; i <= kMaxDeviceId; ++i)
+		if (_index[type][i] == device)
+			_index[type][i] = nullptr;
+}
+template <typename T>
+static int RemoveFrom(std::vector<T*> & devices, T *device) {
+	auto it = std::find(devices.begin(), devices.end(), device);
+	if (it == devices.end())
+		return -1;
+	int idx = (int) (it - devices.begin());
+	devices.erase(it);
+	return idx;
+}
+//------------------- Registration -------------------//
+/**
+ * Called by BaseMotorController, type and ID come from the base arbitration ID.
+ */
+void DeviceCatalog::Register(IMotorController *motorController) {
+	std::lock_guard<std::mutex> lock(_lock);
+	uint32_t baseId = (uint32_t) motorController->GetBaseID();
+	DeviceType type = ((baseId & 0xFFFF0000) == kVictorSPXBaseId) ? VictorSPXType : TalonSRXType;
+	_mcs.push_back(motorController);
+	_mcTypes.push_back((uint8_t) type);
+	Index(type, (int) (baseId & 0x3F), motorController);
+}
+void DeviceCatalog::Register(CTRE::PigeonIMU *pigeon, int deviceId) {
+	std::lock_guard<std::mutex> lock(_lock);
+	_pigeons.push_back(pigeon);
+	Index(PigeonIMUType, deviceId, pigeon);
+}
+void DeviceCatalog::Register(CTRE::CANifier *canifier, int deviceId) {
+	std::lock_guard<std::mutex> lock(_lock);
+	_canifiers.push_back(canifier);
+	Index(CANifierType, deviceId, canifier);
+}
+void DeviceCatalog::Unregister(IMotorController *motorController) {
+	std::lock_guard<std::mutex> lock(_lock);
+	int idx = RemoveFrom(_mcs, motorController);
+	if (idx < 0)
+		return;
+	DeviceType type = (DeviceType) _mcTypes[idx];
+	_mcTypes.erase(_mcTypes.begin() + idx);
+	Unindex(type, motorController);
+}
+void DeviceCatalog::Unregister(CTRE::PigeonIMU *pigeon) {
+	std::lock_guard<std::mutex> lock(_lock);
+	if (RemoveFrom(_pigeons, pigeon) >= 0)
+		Unindex(PigeonIMUType, pigeon);
+}
+void DeviceCatalog::Unregister(CTRE::CANifier *canifier) {
+	std::lock_guard<std::mutex> lock(_lock);
+	if (RemoveFrom(_canifiers, canifier) >= 0)
+		Unindex(CANifierType, canifier);
+}
+//------------------- Lookup -------------------//
+/**
+ * @param type TalonSRXType or VictorSPXType.
+ * @return nullptr if no such controller has been created.
+ */
+IMotorController * DeviceCatalog::FindMotorController(DeviceType type, int deviceId) {
+	if (type > VictorSPXType || deviceId < 0 || deviceId > kMaxDeviceId)
+		return nullptr;
+	return (IMotorController*) _index[type][deviceId];
+}
+CTRE::PigeonIMU * DeviceCatalog::FindPigeon(int deviceId) {
+	if (deviceId < 0 || deviceId > kMaxDeviceId)
+		return nullptr;
+	return (CTRE::PigeonIMU*) _index[PigeonIMUType][deviceId];
+}
+CTRE::CANifier * DeviceCatalog::FindCANifier(int deviceId) {
+	if (deviceId < 0 || deviceId > kMaxDeviceId)
+		return nullptr;
+	return (CTRE::CANifier*) _index[CANifierType][deviceId];
+}
+//------------------- Bulk operations -------------------//
+/**
+ * Put every motor controller in neutral.
+ */
+void DeviceCatalog::NeutralAll() {
+	std::lock_guard<std::mutex> lock(_lock);
+	for (auto mc : _mcs)
+		mc->NeutralOutput();
+}
+/**
+ * Add any catalogued motor controller or Pigeon the cache does not have yet,
+ * then refresh it so every device is read once.
+ */
+void DeviceCatalog::RefreshStatus(CTRE::DeviceCache & cache) {
+	std::lock_guard<std::mutex> lock(_lock);
+	for (auto mc : _mcs)
+		if (cache.Find(mc) < 0)
+			cache.Add(mc);
+	for (auto pigeon : _pigeons)
+		if (cache.Find(pigeon) < 0)
+			cache.Add(pigeon);
+	cache.Refresh();
+}
@@ -0,0 +1,80 @@
+#include "ctre/phoenix/MotorControl/FaultBits.h"
+
+using namespace CTRE::MotorControl;
+
+/* Frame bit of each flag, -1 if the frame does not carry it.  See FaultBits.h */
+static const int8_t kStatus1Bits[FaultBits::kCount] = { 48, 51, 52, 50, 49, 28, 27, -1, -1 };
+static const int8_t kStatus2Bits[FaultBits::kCount] = { -1, 52, 53, 51, 50, 49, 48, -1, -1 };
+
+static uint32_t Decode(uint64_t frame, const int8_t *table) {
+	uint32_t bits = 0;
+	for (int i = 0; i < FaultBits::kCount; ++i)
+		if (table[i] >= 0 && ((frame >> table[i]) & 1))
+			bits |= (1u << i);
+	return bits;
+}
+/** Active faults from a cached Status_1 frame. */
+uint32_t FaultBits::FromStatus1(uint64_t frame) {
+	return Decode(frame, kStatus1Bits);
+}
+/** Sticky faults from a cached Status_2 frame. */
+uint32_t FaultBits::FromStatus2(uint64_t frame) {
+	return Decode(frame, kStatus2Bits);
+}
+uint32_t FaultBits::Pack(const Faults & faults) {
+	uint32_t bits = 0;
+	if (faults.HardwareFailure) bits |= HardwareFailure;
+	if (faults.UnderVoltage) bits |= UnderVoltage;
+	if (faults.OverTemp) bits |= OverTemp;
+	if (faults.ForwardLimitSwitch) bits |= ForwardLimitSwitch;
+	if (faults.ReverseLimitSwitch) bits |= ReverseLimitSwitch;
+	if (faults.ForwardSoftLimit) bits |= ForwardSoftLimit;
+	if (faults.ReverseSoftLimit) bits |= ReverseSoftLimit;
+	if (faults.MsgOverflow) bits |= MsgOverflow;
+	if (faults.ResetDuringEn) bits |= ResetDuringEn;
+	return bits;
+}
+uint32_t FaultBits::Pack(const StickyFaults & faults) {
+	uint32_t bits = 0;
+	if (faults.HardwareFailure) bits |= HardwareFailure;
+	if (faults.UnderVoltage) bits |= UnderVoltage;
+	if (faults.OverTemp) bits |= OverTemp;
+	if (faults.ForwardLimitSwitch) bits |= ForwardLimitSwitch;
+	if (faults.ReverseLimitSwitch) bits |= ReverseLimitSwitch;
+	if (faults.ForwardSoftLimit) bits |= ForwardSoftLimit;
+	if (faults.ReverseSoftLimit) bits |= ReverseSoftLimit;
+	if (faults.MsgOverflow) bits |= MsgOverflow;
+	if (faults.ResetDuringEn) bits |= ResetDuringEn;
+	return bits;
+}
+void FaultBits::Unpack(uint32_t bits, Faults & faults) {
+	faults.HardwareFailure = (bits & HardwareFailure) != 0;
+	faults.UnderVoltage = (bits & UnderVoltage) != 0;
+	faults.OverTemp = (bits & OverTemp) != 0;
+	faults.ForwardLimitSwitch = (bits & ForwardLimitSwitch) != 0;
+	faults.ReverseLimitSwitch = (bits & ReverseLimitSwitch) != 0;
+	faults.ForwardSoftLimit = (bits & ForwardSoftLimit) != 0;
+	faults.ReverseSoftLimit = (bits & ReverseSoftLimit) != 0;
+	faults.MsgOverflow = (bits & MsgOverflow) != 0;
+	faults.ResetDuringEn = (bits & ResetDuringEn) != 0;
+}
+void FaultBits::Unpack(uint32_t bits, StickyFaults & faults) {
+	faults.HardwareFailure = (bits & HardwareFailure) != 0;
+	faults.UnderVoltage = (bits & UnderVoltage) != 0;
+	faults.OverTemp = (bits & OverTemp) != 0;
+	faults.ForwardLimitSwitch = (bits & ForwardLimitSwitch) != 0;
+	faults.ReverseLimitSwitch = (bits & ReverseLimitSwitch) != 0;
+	faults.ForwardSoftLimit = (bits & ForwardSoftLimit) != 0;
+	faults.ReverseSoftLimit = (bits & ReverseSoftLimit) != 0;
+	faults.MsgOverflow = (bits & MsgOverflow) != 0;
+	faults.ResetDuringEn = (bits & ResetDuringEn) != 0;
+}
+/** Field name of flag index [0, kCount). */
+const char * FaultBits::Name(int index) {
+	static const char * const kNames[kCount] = { "HardwareFailure", "UnderVoltage", "OverTemp",
+			"ForwardLimitSwitch", "ReverseLimitSwitch", "ForwardSoftLimit", "ReverseSoftLimit",
+			"MsgOverflow", "ResetDuringEn" };
+	if (index < 0 || index >= kCount)
+		return "";
+	return kNames[index];
+}
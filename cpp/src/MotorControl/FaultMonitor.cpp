@@ -0,0 +1,87 @@
+#include "ctre/phoenix/MotorControl/FaultMonitor.h"
+#include "ctre/phoenix/MotorControl/DeviceCatalog.h"
+
+namespace CTRE {
+namespace MotorControl {
+
+FaultMonitor::FaultMonitor(IFaultEventHandler *handler, uint32_t faultMask) {
+	_handler = handler;
+	_faultMask = faultMask;
+}
+FaultMonitor::Entry * FaultMonitor::Find(IMotorController *motorController) {
+	for (auto & entry : _entries)
+		if (entry.device == motorController)
+			return &entry;
+	return nullptr;
+}
+void FaultMonitor::Dispatch(IMotorController *motorController, uint32_t previous, uint32_t current, bool sticky) {
+	uint32_t changed = previous ^ current;
+	if (changed == 0 || _handler == nullptr)
+		return;
+	for (int i = 0; i < FaultBits::kCount; ++i)
+		if (changed & (1u << i))
+			_handler->OnFault(motorController, i, sticky, (current & (1u << i)) != 0);
+}
+void FaultMonitor::Process() {
+	/* Under the catalog lock, so no controller goes away mid-pass.
+	 * Follow the catalog order, carrying state across when controllers come and go */
+	_next.clear();
+	DeviceCatalog::GetInstance().ForEachMotorController([this](int i, IMotorController *mc) {
+		Entry entry;
+		Entry *old = (i < (int) _entries.size() && _entries[i].device == mc) ? &_entries[i] : Find(mc);
+		if (old != nullptr) {
+			entry = *old;
+		} else {
+			entry.device = mc;
+			entry.faults = 0;
+			entry.sticky = 0;
+		}
+		Poll(entry);
+		_next.push_back(entry);
+	});
+	_entries.swap(_next);
+}
+void FaultMonitor::Poll(Entry & entry) {
+	Faults faults;
+	StickyFaults sticky;
+	ErrorCode e1 = entry.device->GetFaults(faults);
+	ErrorCode e2 = entry.device->GetStickyFaults(sticky);
+	/* Keep the last known state rather than report edges from a missing frame */
+	if (e1 != OK || e2 != OK) {
+		++_readErrors;
+		return;
+	}
+	uint32_t faultBits = FaultBits::Pack(faults) & _faultMask;
+	uint32_t stickyBits = FaultBits::Pack(sticky) & _faultMask;
+	Dispatch(entry.device, entry.faults, faultBits, false);
+	Dispatch(entry.device, entry.sticky, stickyBits, true);
+	entry.faults = faultBits;
+	entry.sticky = stickyBits;
+}
+/** Faults as of the last Process(), 0 if the controller has not been seen. */
+uint32_t FaultMonitor::GetFaultBits(IMotorController *motorController) {
+	Entry *entry = Find(motorController);
+	return (entry != nullptr) ? entry->faults : 0;
+}
+/** Sticky faults as of the last Process(), 0 if the controller has not been seen. */
+uint32_t FaultMonitor::GetStickyFaultBits(IMotorController *motorController) {
+	Entry *entry = Find(motorController);
+	return (entry != nullptr) ? entry->sticky : 0;
+}
+/** Reads skipped because a status frame was missing. */
+uint32_t FaultMonitor::GetReadErrorCount() {
+	return _readErrors;
+}
+void FaultMonitor::OnStart() {
+}
+void FaultMonitor::OnLoop() {
+	Process();
+}
+bool FaultMonitor::IsDone() {
+	return false;
+}
+void FaultMonitor::OnStop() {
+}
+
+} // namespace MotorControl
+} // namespace CTRE
@@ -0,0 +1,93 @@
+#include "ctre/phoenix/MotorControl/MotorStatusTable.h"
+#include "ctre/phoenix/MotorControl/DeviceCatalog.h"
+#include "ctre/phoenix/Timebase.h"
+
+using namespace CTRE::MotorControl;
+
+MotorStatusTable::MotorStatusTable() {
+}
+void MotorStatusTable::Resize(int count) {
+	_devices.resize(count);
+	_positions.resize(count);
+	_velocities.resize(count);
+	_currents.resize(count);
+	_voltages.resize(count);
+	_temperatures.resize(count);
+	_timestampsNs.resize(count);
+	_errors.resize(count);
+}
+/**
+ * Read every catalogued motor controller once.  The getters return what the
+ * driver cached from the last status frames, so this costs no bus traffic.
+ */
+void MotorStatusTable::Update() {
+	/* Under the catalog lock, so no controller goes away mid-pass */
+	int count = DeviceCatalog::GetInstance().ForEachMotorController([this](int i, IMotorController *mc) {
+		if (i >= (int) _devices.size())
+			Resize(i + 1);
+		_devices[i] = mc;
+		_positions[i] = mc->GetSelectedSensorPosition();
+		_velocities[i] = mc->GetSelectedSensorVelocity();
+		ErrorCode e1 = mc->GetOutputCurrent(_currents[i]);
+		ErrorCode e2 = mc->GetBusVoltage(_voltages[i]);
+		ErrorCode e3 = mc->GetTemperature(_temperatures[i]);
+		_timestampsNs[i] = CTRE::Timebase::NowNs();
+		_errors[i] = (e1 != OK) ? e1 : ((e2 != OK) ? e2 : e3);
+	});
+	if (count != (int) _devices.size())
+		Resize(count);
+}
+int MotorStatusTable::GetCount() {
+	return (int) _devices.size();
+}
+/**
+ * @return row of the controller as of the last Update(), -1 if not present.
+ */
+int MotorStatusTable::FindRow(IMotorController *motorController) {
+	for (unsigned int i = 0; i < _devices.size(); ++i)
+		if (_devices[i] == motorController)
+			return (int) i;
+	return -1;
+}
+IMotorController * MotorStatusTable::GetDevice(int row) {
+	return _devices[row];
+}
+/** Sum of output currents in amps. */
+float MotorStatusTable::TotalCurrent() {
+	const float *currents = _currents.data();
+	int count = (int) _currents.size();
+	float total = 0;
+	for (int i = 0; i < count; ++i)
+		total += currents[i];
+	return total;
+}
+/** Hottest controller in Celsius, 0 if there are none. */
+float MotorStatusTable::MaxTemperature() {
+	const float *temperatures = _temperatures.data();
+	int count = (int) _temperatures.size();
+	float hottest = 0;
+	for (int i = 0; i < count; ++i)
+		hottest = (temperatures[i] > hottest) ? temperatures[i] : hottest;
+	return hottest;
+}
+/** Lowest bus voltage seen by any controller, 0 if there are none. */
+float MotorStatusTable::MinVoltage() {
+	const float *voltages = _voltages.data();
+	int count = (int) _voltages.size();
+	if (count == 0)
+		return 0;
+	float lowest = voltages[0];
+	for (int i = 1; i < count; ++i)
+		lowest = (voltages[i] < lowest) ? voltages[i] : lowest;
+	return lowest;
+}
+void MotorStatusTable::OnStart() {
+}
+void MotorStatusTable::OnLoop() {
+	Update();
+}
+bool MotorStatusTable::IsDone() {
+	return false;
+}
+void MotorStatusTable::OnStop() {
+}
@@ -29,6 +29,7 @@
 #include "ctre/phoenix/CCI/Logger_CCI.h"
 #include "ctre/phoenix/CCI/PigeonIMU_CCI.h"
 #include "ctre/phoenix/MotorControl/CAN/TalonSRX.h"
+#include "ctre/phoenix/MotorControl/DeviceCatalog.h"
 
 #include "FRC_NetworkCommunication/CANSessionMux.h"
 
@@ -48,6 +49,7 @@ PigeonIMU::PigeonIMU(int deviceNumber) : CANBusAddressable(deviceNumber)
 	_deviceNumber = deviceNumber;
 	
 	PigeonIMU::ApplyUsageStats(UsageFlags::ConnectCAN);
+	CTRE::MotorControl::DeviceCatalog::GetInstance().Register(this, deviceNumber);
 }
 
 /**
@@ -59,6 +61,12 @@ PigeonIMU::PigeonIMU(CTRE::MotorControl::CAN::TalonSRX * talonSrx) : CANBusAddre
 	m_handle = c_PigeonIMU_Create2(talonSrx->GetDeviceID());
 	_deviceNumber = talonSrx->GetDeviceID();
 	PigeonIMU::ApplyUsageStats(UsageFlags::ConnectTalonSRX);
+	CTRE::MotorControl::DeviceCatalog::GetInstance().Register(this, _deviceNumber);
+}
+
+PigeonIMU::~PigeonIMU()
+{
+	CTRE::MotorControl::DeviceCatalog::GetInstance().Unregister(this);
 }
 
 //----------------------- Control Param routines -----------------------//
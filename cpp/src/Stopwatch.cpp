@@ -1,18 +1,33 @@
 #include "ctre/phoenix/Stopwatch.h"
+#include "ctre/phoenix/Timebase.h"
 
 namespace CTRE {
 
 void Stopwatch::Start(){
-	_t0 = (float)clock();
+	_t0 = Timebase::NowNs();
 }
 unsigned int Stopwatch::DurationMs(){
-	return Stopwatch::Duration() * 1000;
+	return (unsigned int)(DurationNs() / 1000000);
 }
+/** Seconds since Start(). */
 float Stopwatch::Duration(){
-	_t1 = (float)clock();
-	long retval = _t1 - _t0;
+	return DurationNs() * 1e-9f;
+}
+int64_t Stopwatch::DurationNs(){
+	int64_t retval = Timebase::NowNs() - _t0;
+	if(retval < 0) retval = 0;
+	return retval;
+}
+/**
+ * Seconds since Start() or the previous Lap(), then restart.
+ * Reads the clock once so no time is lost between laps.
+ */
+float Stopwatch::Lap(){
+	int64_t now = Timebase::NowNs();
+	int64_t retval = now - _t0;
+	_t0 = now;
 	if(retval < 0) retval = 0;
-	return retval * _scalar;
+	return retval * 1e-9f;
 }
 
 }
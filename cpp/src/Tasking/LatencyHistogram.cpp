@@ -0,0 +1,83 @@
+#include "ctre/phoenix/Tasking/LatencyHistogram.h"
+
+namespace CTRE {
+namespace Tasking {
+
+LatencyHistogram::LatencyHistogram() {
+	Reset();
+}
+void LatencyHistogram::Reset() {
+	for (int i = 0; i < kBucketCount; ++i)
+		_counts[i].store(0, std::memory_order_relaxed);
+	_total.store(0, std::memory_order_relaxed);
+	_min.store(INT64_MAX, std::memory_order_relaxed);
+	_max.store(0, std::memory_order_relaxed);
+	_sum.store(0, std::memory_order_relaxed);
+}
+int LatencyHistogram::BucketIndex(int64_t ns) {
+	if (ns < kSubBuckets)
+		return (ns < 0) ? 0 : (int) ns;
+	int msb = 63 - __builtin_clzll((unsigned long long) ns);
+	if (msb > kMaxMsb)
+		return kBucketCount - 1;
+	int sub = (int) (ns >> (msb - kSubBucketBits)) & (kSubBuckets - 1);
+	return kSubBuckets + (msb - kSubBucketBits) * kSubBuckets + sub;
+}
+/** Largest value that lands in the bucket. */
+int64_t LatencyHistogram::BucketUpperBound(int index) {
+	if (index < kSubBuckets)
+		return index;
+	int msb = (index - kSubBuckets) / kSubBuckets + kSubBucketBits;
+	int sub = (index - kSubBuckets) % kSubBuckets;
+	int shift = msb - kSubBucketBits;
+	return ((int64_t) (kSubBuckets + sub + 1) << shift) - 1;
+}
+void LatencyHistogram::Record(int64_t ns) {
+	/* Single writer, plain load/store keeps this free of atomic RMW */
+	int idx = BucketIndex(ns);
+	_counts[idx].store(_counts[idx].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	_total.store(_total.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	_sum.store(_sum.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+	if (ns < _min.load(std::memory_order_relaxed))
+		_min.store(ns, std::memory_order_relaxed);
+	if (ns > _max.load(std::memory_order_relaxed))
+		_max.store(ns, std::memory_order_relaxed);
+}
+uint32_t LatencyHistogram::GetCount() const {
+	return _total.load(std::memory_order_relaxed);
+}
+int64_t LatencyHistogram::GetMin() const {
+	return (GetCount() > 0) ? _min.load(std::memory_order_relaxed) : 0;
+}
+int64_t LatencyHistogram::GetMax() const {
+	return _max.load(std::memory_order_relaxed);
+}
+int64_t LatencyHistogram::GetMean() const {
+	uint32_t count = GetCount();
+	return (count > 0) ? _sum.load(std::memory_order_relaxed) / count : 0;
+}
+/**
+ * @param percent	0 to 100.
+ * @return upper bound of the bucket holding that percentile, capped at the max seen.
+ */
+int64_t LatencyHistogram::GetPercentile(double percent) const {
+	uint32_t count = GetCount();
+	if (count == 0)
+		return 0;
+	uint64_t target = (uint64_t) (percent / 100.0 * count + 0.5);
+	if (target < 1)
+		target = 1;
+	uint64_t seen = 0;
+	for (int i = 0; i < kBucketCount; ++i) {
+		seen += _counts[i].load(std::memory_order_relaxed);
+		if (seen >= target) {
+			int64_t bound = BucketUpperBound(i);
+			int64_t max = GetMax();
+			return (bound < max) ? bound : max;
+		}
+	}
+	return GetMax();
+}
+
+} // namespace Tasking
+} // namespace CTRE
@@ -0,0 +1,143 @@
+#include "ctre/phoenix/Tasking/LoopProfiler.h"
+#include "ctre/phoenix/Timebase.h"
+#include "ctre/phoenix/CTRLogger.h"
+#include <stdio.h>
+#include <time.h>
+
+namespace CTRE {
+namespace Tasking {
+
+/**
+ * @param budgetUs	OnLoop calls longer than this count as an overrun.
+ * @param dumpPeriodMs	How often Poll() logs a summary, 0 to disable.
+ */
+LoopProfiler::LoopProfiler(int budgetUs, int dumpPeriodMs) {
+	_budgetNs = (int64_t) budgetUs * 1000;
+	_dumpPeriodNs = (int64_t) dumpPeriodMs * 1000000;
+	_nextDumpNs = Timebase::NowNs() + _dumpPeriodNs;
+}
+LoopProfiler::~LoopProfiler() {
+	for (auto profile : _profiles)
+		delete profile;
+}
+/**
+ * Find or create the profile for a loopable.  Schedulers call this when
+ * a loopable is added, the returned pointer stays valid for the profiler's life.
+ */
+LoopProfile * LoopProfiler::Register(ILoopable *aLoop) {
+	std::lock_guard<std::mutex> lock(_lock);
+	for (auto profile : _profiles) {
+		if (profile->loop == aLoop)
+			return profile;
+	}
+	LoopProfile *profile = new LoopProfile();
+	profile->loop = aLoop;
+	profile->overruns = 0;
+	profile->worstOverrunNs = 0;
+	char origin[48];
+	snprintf(origin, sizeof(origin), "Loop Profiler %p", (void*) aLoop);
+	profile->originId = CTRLogger::Origin(origin);
+	_profiles.push_back(profile);
+	return profile;
+}
+LoopProfile * LoopProfiler::Get(ILoopable *aLoop) {
+	std::lock_guard<std::mutex> lock(_lock);
+	for (auto profile : _profiles) {
+		if (profile->loop == aLoop)
+			return profile;
+	}
+	return nullptr;
+}
+int LoopProfiler::GetCount() {
+	std::lock_guard<std::mutex> lock(_lock);
+	return (int) _profiles.size();
+}
+LoopProfile * LoopProfiler::GetAt(int idx) {
+	std::lock_guard<std::mutex> lock(_lock);
+	if (idx < 0 || idx >= (int) _profiles.size())
+		return nullptr;
+	return _profiles[idx];
+}
+void LoopProfiler::SetBudget(int budgetUs) {
+	_budgetNs = (int64_t) budgetUs * 1000;
+}
+void LoopProfiler::SetDumpPeriod(int dumpPeriodMs) {
+	_dumpPeriodNs = (int64_t) dumpPeriodMs * 1000000;
+	_nextDumpNs = Timebase::NowNs() + _dumpPeriodNs;
+}
+void LoopProfiler::Reset() {
+	std::lock_guard<std::mutex> lock(_lock);
+	for (auto profile : _profiles) {
+		profile->onStart.Reset();
+		profile->onLoop.Reset();
+		profile->onStop.Reset();
+		profile->overruns = 0;
+		profile->worstOverrunNs = 0;
+	}
+}
+/* Execution time is always wall time, a simulated Timebase clock would
+ * read 0 or the size of a jump.  Timebase only schedules the dumps. */
+static int64_t ElapsedClockNs() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+int64_t LoopProfiler::Begin() {
+	return ElapsedClockNs();
+}
+void LoopProfiler::Record(LoopProfile *profile, Phase phase, int64_t startNs) {
+	int64_t dur = ElapsedClockNs() - startNs;
+	switch (phase) {
+		case Start:
+			profile->onStart.Record(dur);
+			break;
+		case Loop:
+			profile->onLoop.Record(dur);
+			if (dur > _budgetNs.load(std::memory_order_relaxed)) {
+				profile->overruns.fetch_add(1, std::memory_order_relaxed);
+				if (dur > profile->worstOverrunNs.load(std::memory_order_relaxed))
+					profile->worstOverrunNs.store(dur, std::memory_order_relaxed);
+			}
+			break;
+		case Stop:
+			profile->onStop.Record(dur);
+			break;
+	}
+}
+/**
+ * Called by the schedulers once per Process(), logs a summary when the
+ * dump period has elapsed.
+ */
+void LoopProfiler::Poll() {
+	int64_t period = _dumpPeriodNs.load(std::memory_order_relaxed);
+	if (period <= 0)
+		return;
+	int64_t now = Timebase::NowNs();
+	int64_t next = _nextDumpNs.load(std::memory_order_relaxed);
+	if (now < next)
+		return;
+	/* Only one caller wins the dump when shared between schedulers */
+	if (_nextDumpNs.compare_exchange_strong(next, now + period) == false)
+		return;
+	Dump();
+}
+/**
+ * Log one line per loopable through CTRLogger, loopables that overran
+ * their budget are logged as warnings.
+ */
+void LoopProfiler::Dump() {
+	std::lock_guard<std::mutex> lock(_lock);
+	for (auto profile : _profiles) {
+		const LatencyHistogram & h = profile->onLoop;
+		char line[200];
+		snprintf(line, sizeof(line), "Loop %p: n=%u mean=%lldus p50=%lldus p99=%lldus max=%lldus overruns=%u worst=%lldus",
+				(void*) profile->loop, h.GetCount(), (long long) h.GetMean() / 1000,
+				(long long) h.GetPercentile(50) / 1000, (long long) h.GetPercentile(99) / 1000,
+				(long long) h.GetMax() / 1000, profile->overruns.load(),
+				(long long) profile->worstOverrunNs.load() / 1000);
+		CTRLogger::Log((profile->overruns.load() > 0) ? GeneralWarning : OKAY, profile->originId, line);
+	}
+}
+
+} // namespace Tasking
+} // namespace CTRE
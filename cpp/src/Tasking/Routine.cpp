@@ -0,0 +1,35 @@
+#include "ctre/phoenix/Tasking/Routine.h"
+
+namespace CTRE {
+namespace Tasking {
+
+void Routine::OnStart() {
+	_resumeLine = 0;
+	_isDone = false;
+	_child = nullptr;
+}
+void Routine::OnLoop() {
+	if (_isDone)
+		return;
+	Run();
+}
+bool Routine::IsDone() {
+	return _isDone;
+}
+void Routine::OnStop() {
+	/* Stop whatever we were waiting on */
+	if (_child != nullptr) {
+		_child->OnStop();
+		_child = nullptr;
+	}
+	_isDone = true;
+}
+void Routine::BeginWait() {
+	_waitTimer.Start();
+}
+unsigned int Routine::WaitedMs() {
+	return _waitTimer.DurationMs();
+}
+
+} // namespace Tasking
+} // namespace CTRE
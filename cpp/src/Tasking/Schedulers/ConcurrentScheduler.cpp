@@ -8,62 +8,250 @@ ConcurrentScheduler::ConcurrentScheduler() {
 }
 ConcurrentScheduler::~ConcurrentScheduler() {
 }
-void ConcurrentScheduler::Add(ILoopable *aLoop, bool enable) {
-	_loops.push_back(aLoop);
-	_enabs.push_back(enable);
+ConcurrentScheduler::Handle ConcurrentScheduler::Add(ILoopable *aLoop, bool enable) {
+	Entry e;
+	e.loop = aLoop;
+	e.enabled = false;
+	e.activeSlot = -1;
+	e.affinity = -1;
+	e.profile = (_profiler != nullptr) ? _profiler->Register(aLoop) : nullptr;
+	_entries.push_back(e);
+
+	Handle handle = (Handle) _entries.size() - 1;
+	if (enable)
+		Activate(handle);
+	return handle;
 }
 void ConcurrentScheduler::RemoveAll() {
-	_loops.clear();
-	_enabs.clear();
+	_entries.clear();
+	_active.clear();
+	_activeCount = 0;
+	_dirty = false;
 }
-void ConcurrentScheduler::Start(ILoopable* toStart) {
-	for (int i = 0; i < (int) _loops.size(); ++i) {
-		ILoopable* lp = (ILoopable*) _loops[i];
-
-		if (lp == toStart) {
-			_enabs[i] = true;
-			lp->OnStart();
-			return;
-		}
+/* Both O(1).  While a tick is running _active is only appended to, stopped
+ * entries stay in it until Compact() so no loopable is skipped. */
+void ConcurrentScheduler::Activate(Handle handle) {
+	Entry & e = _entries[handle];
+	if (e.enabled)
+		return;
+	e.enabled = true;
+	++_activeCount;
+	if (e.activeSlot >= 0)
+		return;
+	e.activeSlot = (int) _active.size();
+	_active.push_back(handle);
+}
+void ConcurrentScheduler::Deactivate(Handle handle) {
+	Entry & e = _entries[handle];
+	if (e.enabled == false)
+		return;
+	e.enabled = false;
+	--_activeCount;
+	if (_iterating)
+		_dirty = true;
+	else
+		Unlist(handle);
+}
+/* Swap-remove from _active */
+void ConcurrentScheduler::Unlist(Handle handle) {
+	Entry & e = _entries[handle];
+	Handle last = _active.back();
+	_active[e.activeSlot] = last;
+	_entries[last].activeSlot = e.activeSlot;
+	_active.pop_back();
+	e.activeSlot = -1;
+}
+/* Drop entries stopped during the tick, one pass over the active list */
+void ConcurrentScheduler::Compact() {
+	if (_dirty == false)
+		return;
+	for (int i = 0; i < (int) _active.size();) {
+		Handle handle = _active[i];
+		if (_entries[handle].enabled)
+			++i;
+		else
+			Unlist(handle);
 	}
-
+	_dirty = false;
+}
+void ConcurrentScheduler::Start(Handle toStart) {
+	if (toStart < 0 || toStart >= (Handle) _entries.size())
+		return;
+	Activate(toStart);
+	CallStart(toStart);
+}
+void ConcurrentScheduler::Stop(Handle toStop) {
+	if (toStop < 0 || toStop >= (Handle) _entries.size())
+		return;
+	Deactivate(toStop);
+	CallStop(toStop);
+}
+void ConcurrentScheduler::Start(ILoopable* toStart) {
+	Start(Find(toStart));
 }
 void ConcurrentScheduler::Stop(ILoopable* toStop) {
-	for (int i = 0; i < (int) _loops.size(); ++i) {
-		ILoopable* lp = (ILoopable*) _loops[i];
-
-		if (lp == toStop) {
-			_enabs[i] = false;
-			lp->OnStop();
-			return;
-		}
-	}
+	Stop(Find(toStop));
 }
 void ConcurrentScheduler::StartAll() {	//All Loops
-	for (auto loop : _loops) {
-		loop->OnStart();
-	}
-	for (auto enable : _enabs) {
-		enable = true;
+	for (int i = 0; i < (int) _entries.size(); ++i) {
+		Activate(i);
+		CallStart(i);
 	}
 }
 void ConcurrentScheduler::StopAll() {	//All Loops
-	for (auto loop : _loops) {
-		loop->OnStop();
+	for (int i = 0; i < (int) _entries.size(); ++i) {
+		Deactivate(i);
+		CallStop(i);
+	}
+}
+bool ConcurrentScheduler::IsEnabled(Handle handle) {
+	if (handle < 0 || handle >= (Handle) _entries.size())
+		return false;
+	return _entries[handle].enabled;
+}
+/**
+ * Look up the handle of a loopable added earlier, linear in the number added.
+ * @return -1 if not found.
+ */
+ConcurrentScheduler::Handle ConcurrentScheduler::Find(ILoopable *aLoop) {
+	for (int i = 0; i < (int) _entries.size(); ++i) {
+		if (_entries[i].loop == aLoop)
+			return i;
+	}
+	return -1;
+}
+int ConcurrentScheduler::GetCount() {
+	return (int) _entries.size();
+}
+int ConcurrentScheduler::GetActiveCount() {
+	return _activeCount;
+}
+/**
+ * Run enabled loopables on a thread pool instead of the calling thread.
+ * Process() still returns only once every loopable has finished its OnLoop.
+ * Loopables must not start or stop others in this scheduler from OnLoop
+ * while running in parallel.
+ * @param pool	Pool to run on, nullptr to go back to running serially.
+ */
+void ConcurrentScheduler::SetThreadPool(ThreadPool *pool) {
+	_pool = pool;
+}
+/**
+ * Loopables that share devices can be given the same group so they
+ * never run at the same time.  Members of a group run one after another on one thread.
+ * @param group	Group number, -1 to let the loopable run on its own.
+ */
+void ConcurrentScheduler::SetAffinity(Handle handle, int group) {
+	if (handle < 0 || handle >= (Handle) _entries.size())
+		return;
+	_entries[handle].affinity = group;
+}
+void ConcurrentScheduler::SetAffinity(ILoopable *aLoop, int group) {
+	SetAffinity(Find(aLoop), group);
+}
+/**
+ * Time every OnStart/OnLoop/OnStop into the profiler, nullptr to stop timing.
+ */
+void ConcurrentScheduler::SetProfiler(LoopProfiler *profiler) {
+	_profiler = profiler;
+	for (auto & e : _entries)
+		e.profile = (profiler != nullptr) ? profiler->Register(e.loop) : nullptr;
+}
+/**
+ * Refresh this cache at the start of every tick, before any loopable runs.
+ * nullptr to stop refreshing.
+ */
+void ConcurrentScheduler::SetDeviceCache(CTRE::DeviceCache *cache) {
+	_deviceCache = cache;
+}
+void ConcurrentScheduler::CallStart(Handle handle) {
+	Entry & e = _entries[handle];
+	if (e.profile == nullptr) {
+		e.loop->OnStart();
+		return;
 	}
-	for (auto enable : _enabs) {
-		enable = false;
+	int64_t t = LoopProfiler::Begin();
+	e.loop->OnStart();
+	_profiler->Record(e.profile, LoopProfiler::Start, t);
+}
+void ConcurrentScheduler::CallLoop(Handle handle) {
+	Entry & e = _entries[handle];
+	if (e.profile == nullptr) {
+		e.loop->OnLoop();
+		return;
 	}
+	int64_t t = LoopProfiler::Begin();
+	e.loop->OnLoop();
+	_profiler->Record(e.profile, LoopProfiler::Loop, t);
+}
+void ConcurrentScheduler::CallStop(Handle handle) {
+	Entry & e = _entries[handle];
+	if (e.profile == nullptr) {
+		e.loop->OnStop();
+		return;
+	}
+	int64_t t = LoopProfiler::Begin();
+	e.loop->OnStop();
+	_profiler->Record(e.profile, LoopProfiler::Stop, t);
 }
 void ConcurrentScheduler::Process() {
-	for (int i = 0; i < (int) _loops.size(); ++i) {
-		ILoopable* loop = (ILoopable*) _loops[i];
-		bool en = (bool) _enabs[i];
-		if (en) {
-			loop->OnLoop();
+	if (_deviceCache != nullptr && _activeCount > 0)
+		_deviceCache->Refresh();
+	_iterating = true;
+	if (_pool != nullptr) {
+		ProcessParallel();
+	} else {
+		/* Loopables stopped during the pass stay listed until Compact(),
+		 * ones started during it are appended and run this tick */
+		for (int i = 0; i < (int) _active.size(); ++i) {
+			Handle handle = _active[i];
+			if (_entries[handle].enabled)
+				CallLoop(handle);
+		}
+	}
+	_iterating = false;
+	Compact();
+	if (_profiler != nullptr)
+		_profiler->Poll();
+}
+void ConcurrentScheduler::ProcessParallel() {
+	/* Rebuild this tick's groups, vectors keep their capacity between ticks */
+	for (int g = 0; g < _groupCount; ++g)
+		_groups[g].loops.clear();
+	_groupCount = 0;
+
+	for (auto handle : _active) {
+		if (_entries[handle].enabled == false)
+			continue;
+		int affinity = _entries[handle].affinity;
+
+		int g = 0;
+		if (affinity >= 0) {
+			while (g < _groupCount && _groups[g].affinity != affinity)
+				++g;
 		} else {
-			/* Current ILoopable is turned off, don't call OnLoop for it */
+			g = _groupCount;
+		}
+		if (g == _groupCount) {
+			if (_groupCount == (int) _groups.size())
+				_groups.push_back(ParallelGroup());
+			_groups[g].owner = this;
+			_groups[g].affinity = affinity;
+			++_groupCount;
 		}
+		_groups[g].loops.push_back(handle);
+	}
+
+	for (int g = 0; g < _groupCount; ++g)
+		_pool->Submit(&ConcurrentScheduler::RunGroup, &_groups[g], _groups[g].affinity);
+
+	/* End of tick barrier */
+	_pool->Wait();
+}
+void ConcurrentScheduler::RunGroup(void *group) {
+	ParallelGroup *pg = (ParallelGroup*) group;
+	for (auto handle : pg->loops) {
+		pg->owner->CallLoop(handle);
 	}
 }
 /* ILoopable */
@@ -83,4 +271,3 @@ bool ConcurrentScheduler::IsDone() {
 } // namespace Schedulers
 } // namespace Tasking
 } // namespace CTRE
-
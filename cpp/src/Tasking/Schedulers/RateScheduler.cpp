@@ -0,0 +1,185 @@
+#include "ctre/phoenix/Tasking/Schedulers/RateScheduler.h"
+#include "ctre/phoenix/Timebase.h"
+
+namespace CTRE {
+namespace Tasking {
+namespace Schedulers {
+
+RateScheduler::RateScheduler() {
+	_threadRunning = false;
+}
+RateScheduler::~RateScheduler() {
+	StopThread();
+}
+/**
+ * Add before calling StartThread() and never from a loopable's OnLoop,
+ * the pass iterates the entry list.
+ * @param periodUs	Period in microseconds.
+ * @param priority	Higher runs first when several loopables are due together.
+ */
+void RateScheduler::Add(ILoopable *aLoop, int periodUs, int priority, bool enable) {
+	Entry e = { };
+	e.loop = aLoop;
+	e.periodNs = (int64_t) (periodUs > 0 ? periodUs : 1) * 1000;
+	e.priority = priority;
+	e.enabled = enable;
+	e.deadlineNs = Timebase::NowNs();
+
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	auto it = _entries.begin();
+	while (it != _entries.end() && it->priority >= priority)
+		++it;
+	_entries.insert(it, e);
+}
+void RateScheduler::RemoveAll() {
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	_entries.clear();
+}
+void RateScheduler::Start(ILoopable *toStart) {
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	for (auto & e : _entries) {
+		if (e.loop == toStart) {
+			e.enabled = true;
+			e.deadlineNs = Timebase::NowNs();
+			e.loop->OnStart();
+			return;
+		}
+	}
+}
+void RateScheduler::Stop(ILoopable *toStop) {
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	for (auto & e : _entries) {
+		if (e.loop == toStop) {
+			e.enabled = false;
+			e.loop->OnStop();
+			return;
+		}
+	}
+}
+void RateScheduler::StartAll() {
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	int64_t now = Timebase::NowNs();
+	for (auto & e : _entries) {
+		e.enabled = true;
+		e.deadlineNs = now;
+		e.loop->OnStart();
+	}
+}
+void RateScheduler::StopAll() {
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	for (auto & e : _entries) {
+		e.enabled = false;
+		e.loop->OnStop();
+	}
+}
+bool RateScheduler::GetStats(ILoopable *aLoop, Stats & stats) {
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	for (auto & e : _entries) {
+		if (e.loop == aLoop) {
+			stats = e.stats;
+			return true;
+		}
+	}
+	return false;
+}
+void RateScheduler::ResetStats() {
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	for (auto & e : _entries)
+		e.stats = Stats { };
+}
+/**
+ * Refresh this cache once per pass that has loopables due, before they run.
+ * nullptr to stop refreshing.
+ */
+void RateScheduler::SetDeviceCache(CTRE::DeviceCache *cache) {
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	_deviceCache = cache;
+}
+/**
+ * Run every enabled loopable whose deadline has passed.
+ * @return the earliest upcoming deadline.
+ */
+int64_t RateScheduler::RunDue(int64_t nowNs) {
+	/* Held for the whole pass, Start/Stop from other threads wait for it.
+	 * Recursive so a loopable may still start or stop others from OnLoop. */
+	std::lock_guard<std::recursive_mutex> lock(_lock);
+	int64_t next = nowNs + 1000000000LL;
+	bool refreshed = false;
+	for (auto & e : _entries) {
+		if (e.enabled == false)
+			continue;
+		if (e.deadlineNs <= nowNs) {
+			/* One snapshot for everything due in this pass */
+			if (refreshed == false && _deviceCache != nullptr) {
+				_deviceCache->Refresh();
+				refreshed = true;
+			}
+			int64_t start = Timebase::NowNs();
+			int64_t jitter = start - e.deadlineNs;
+			e.loop->OnLoop();
+
+			e.stats.runs++;
+			e.stats.lastJitterNs = jitter;
+			e.stats.sumJitterNs += jitter;
+			if (jitter > e.stats.maxJitterNs)
+				e.stats.maxJitterNs = jitter;
+
+			/* Stay on the original grid, skipping periods we were too late for */
+			e.deadlineNs += e.periodNs;
+			if (e.deadlineNs <= start) {
+				int64_t skipped = (start - e.deadlineNs) / e.periodNs + 1;
+				e.stats.missed += (unsigned int) skipped;
+				e.deadlineNs += skipped * e.periodNs;
+			}
+		}
+		if (e.deadlineNs < next)
+			next = e.deadlineNs;
+	}
+	return next;
+}
+/**
+ * Start a dedicated thread that sleeps until the next deadline.
+ * @return false if already running.
+ */
+bool RateScheduler::StartThread() {
+	if (_threadRunning.exchange(true))
+		return false;
+	_thread = std::thread(&RateScheduler::ThreadLoop, this);
+	return true;
+}
+void RateScheduler::StopThread() {
+	if (_threadRunning.exchange(false) == false)
+		return;
+	if (_thread.joinable())
+		_thread.join();
+}
+void RateScheduler::ThreadLoop() {
+	while (_threadRunning.load(std::memory_order_relaxed)) {
+		int64_t next = RunDue(Timebase::NowNs());
+		/* Cap the sleep so StopThread() is honored promptly */
+		int64_t cap = Timebase::NowNs() + 100000000LL;
+		if (next > cap)
+			next = cap;
+		Timebase::SleepUntilNs(next);
+	}
+}
+void RateScheduler::Process() {
+	RunDue(Timebase::NowNs());
+}
+/* ILoopable */
+void RateScheduler::OnStart() {
+	RateScheduler::StartAll();
+}
+void RateScheduler::OnLoop() {
+	RateScheduler::Process();
+}
+void RateScheduler::OnStop() {
+	RateScheduler::StopAll();
+}
+bool RateScheduler::IsDone() {
+	return false;
+}
+
+} // namespace Schedulers
+} // namespace Tasking
+} // namespace CTRE
@@ -10,6 +10,7 @@ SequentialScheduler::~SequentialScheduler() {
 }
 void SequentialScheduler::Add(ILoopable *aLoop) {
 	_loops.push_back(aLoop);
+	_profiles.push_back((_profiler != nullptr) ? _profiler->Register(aLoop) : nullptr);
 }
 ILoopable * SequentialScheduler::GetCurrent() {
 	ILoopable* retval = nullptr;
@@ -21,6 +22,7 @@ ILoopable * SequentialScheduler::GetCurrent() {
 
 void SequentialScheduler::RemoveAll() {
 	_loops.clear();
+	_profiles.clear();
 }
 void SequentialScheduler::Start() {
 	/* reset iterator regardless of loopable container */
@@ -31,34 +33,80 @@ void SequentialScheduler::Start() {
 		_running = false;
 	} else {
 		/* start the first one */
-		_loops[_idx]->OnStart();
+		CallStart(_idx);
 		_running = true;
 	}
 
 }
 void SequentialScheduler::Stop() {
 	for (unsigned int i = 0; i < _loops.size(); i++) {
-		_loops[i]->OnStop();
+		CallStop(i);
 	}
 	_running = false;
 }
 void SequentialScheduler::Process() {
 	if (_idx < _loops.size()) {
 		if (_running) {
+			if (_deviceCache != nullptr)
+				_deviceCache->Refresh();
 			ILoopable* loop = _loops[_idx];
-			loop->OnLoop();
+			CallLoop(_idx);
 			if (loop->IsDone()) {
 				/* iterate to next loopable */
 				++_idx;
 				if (_idx < _loops.size()) {
 					/* callback to start it */
-					_loops[_idx]->OnStart();
+					CallStart(_idx);
 				}
 			}
 		}
 	} else {
 		_running = false;
 	}
+	if (_profiler != nullptr)
+		_profiler->Poll();
+}
+/**
+ * Time every OnStart/OnLoop/OnStop into the profiler, nullptr to stop timing.
+ */
+void SequentialScheduler::SetProfiler(LoopProfiler *profiler) {
+	_profiler = profiler;
+	for (unsigned int i = 0; i < _loops.size(); ++i)
+		_profiles[i] = (profiler != nullptr) ? profiler->Register(_loops[i]) : nullptr;
+}
+/**
+ * Refresh this cache at the start of every tick, before the current loopable runs.
+ * nullptr to stop refreshing.
+ */
+void SequentialScheduler::SetDeviceCache(CTRE::DeviceCache *cache) {
+	_deviceCache = cache;
+}
+void SequentialScheduler::CallStart(unsigned int idx) {
+	if (_profiles[idx] == nullptr) {
+		_loops[idx]->OnStart();
+		return;
+	}
+	int64_t t = LoopProfiler::Begin();
+	_loops[idx]->OnStart();
+	_profiler->Record(_profiles[idx], LoopProfiler::Start, t);
+}
+void SequentialScheduler::CallLoop(unsigned int idx) {
+	if (_profiles[idx] == nullptr) {
+		_loops[idx]->OnLoop();
+		return;
+	}
+	int64_t t = LoopProfiler::Begin();
+	_loops[idx]->OnLoop();
+	_profiler->Record(_profiles[idx], LoopProfiler::Loop, t);
+}
+void SequentialScheduler::CallStop(unsigned int idx) {
+	if (_profiles[idx] == nullptr) {
+		_loops[idx]->OnStop();
+		return;
+	}
+	int64_t t = LoopProfiler::Begin();
+	_loops[idx]->OnStop();
+	_profiler->Record(_profiles[idx], LoopProfiler::Stop, t);
 }
 /* ILoopable */
 void SequentialScheduler::OnStart() {
@@ -0,0 +1,221 @@
+#include "ctre/phoenix/Tasking/Schedulers/TaskGraphScheduler.h"
+#include "HAL/DriverStation.h"
+
+namespace CTRE {
+namespace Tasking {
+namespace Schedulers {
+
+TaskGraphScheduler::TaskGraphScheduler() {
+}
+TaskGraphScheduler::~TaskGraphScheduler() {
+}
+TaskGraphScheduler::Node TaskGraphScheduler::AddNode(Kind kind, std::initializer_list<ILoopable*> loops) {
+	NodeData nd;
+	nd.kind = kind;
+	nd.state = Waiting;
+	nd.loops.assign(loops.begin(), loops.end());
+	nd.loopDone.assign(nd.loops.size(), 0);
+	nd.dependencyCount = 0;
+	nd.remaining = 0;
+	_nodes.push_back(nd);
+	return (Node) _nodes.size() - 1;
+}
+TaskGraphScheduler::Node TaskGraphScheduler::Add(ILoopable *aLoop) {
+	return AddNode(Single, { aLoop });
+}
+TaskGraphScheduler::Node TaskGraphScheduler::AddParallel(std::initializer_list<ILoopable*> loops) {
+	return AddNode(Parallel, loops);
+}
+/**
+ * @return -1 if loops is empty, a race with no members would never finish.
+ */
+TaskGraphScheduler::Node TaskGraphScheduler::AddRace(std::initializer_list<ILoopable*> loops) {
+	if (loops.size() == 0) {
+		HAL_SendError(false, 1, false, "CTR: Task Graph Scheduler race needs at least one loopable", "", "", true);
+		return -1;
+	}
+	return AddNode(Race, loops);
+}
+/**
+ * @param deadline	Node finishes when this loopable is done.
+ * @param others	Run alongside the deadline, stopped if still running when it finishes.
+ */
+TaskGraphScheduler::Node TaskGraphScheduler::AddDeadline(ILoopable *deadline, std::initializer_list<ILoopable*> others) {
+	Node node = AddNode(Deadline, { deadline });
+	NodeData & nd = _nodes[node];
+	nd.loops.insert(nd.loops.end(), others.begin(), others.end());
+	nd.loopDone.assign(nd.loops.size(), 0);
+	return node;
+}
+/**
+ * Make node wait for dependsOn to be done.  Add edges before Start().
+ * @return false if either node is invalid.
+ */
+bool TaskGraphScheduler::AddDependency(Node node, Node dependsOn) {
+	if (node < 0 || node >= (Node) _nodes.size())
+		return false;
+	if (dependsOn < 0 || dependsOn >= (Node) _nodes.size() || dependsOn == node)
+		return false;
+	_nodes[dependsOn].successors.push_back(node);
+	_nodes[node].dependencyCount++;
+	return true;
+}
+void TaskGraphScheduler::RemoveAll() {
+	_nodes.clear();
+	_running.clear();
+	_started = false;
+}
+/**
+ * Loop running nodes on a thread pool, nullptr to run them on the calling thread.
+ */
+void TaskGraphScheduler::SetThreadPool(ThreadPool *pool) {
+	_pool = pool;
+}
+void TaskGraphScheduler::Start() {
+	_running.clear();
+	for (auto & nd : _nodes) {
+		nd.state = Waiting;
+		nd.remaining = nd.dependencyCount;
+	}
+
+	/* Every node must be reachable from a root, otherwise there is a cycle */
+	std::vector<int> remaining(_nodes.size());
+	std::vector<Node> order;
+	for (int i = 0; i < (int) _nodes.size(); ++i) {
+		remaining[i] = _nodes[i].dependencyCount;
+		if (remaining[i] == 0)
+			order.push_back(i);
+	}
+	for (int i = 0; i < (int) order.size(); ++i) {
+		for (auto succ : _nodes[order[i]].successors) {
+			if (--remaining[succ] == 0)
+				order.push_back(succ);
+		}
+	}
+	if (order.size() != _nodes.size())
+		HAL_SendError(false, 1, false, "CTR: Task Graph Scheduler has a dependency cycle, some nodes will never run", "", "", true);
+
+	_started = true;
+	for (int i = 0; i < (int) _nodes.size(); ++i) {
+		if (_nodes[i].remaining == 0)
+			StartNode(i);
+	}
+}
+void TaskGraphScheduler::Stop() {
+	for (auto node : _running) {
+		NodeData & nd = _nodes[node];
+		for (int i = 0; i < (int) nd.loops.size(); ++i) {
+			if (nd.loopDone[i] == 0)
+				nd.loops[i]->OnStop();
+		}
+		nd.state = Finished;
+	}
+	_running.clear();
+	_started = false;
+}
+void TaskGraphScheduler::StartNode(Node node) {
+	NodeData & nd = _nodes[node];
+	nd.state = Running;
+	for (int i = 0; i < (int) nd.loops.size(); ++i) {
+		nd.loopDone[i] = 0;
+		nd.loops[i]->OnStart();
+	}
+	_running.push_back(node);
+}
+bool TaskGraphScheduler::IsNodeDone(Node node) {
+	if (node < 0 || node >= (Node) _nodes.size())
+		return false;
+	return _nodes[node].state == Finished;
+}
+int TaskGraphScheduler::GetRunningCount() {
+	return (int) _running.size();
+}
+void TaskGraphScheduler::RunNode(void *node) {
+	NodeData *nd = (NodeData*) node;
+	for (int i = 0; i < (int) nd->loops.size(); ++i) {
+		if (nd->loopDone[i])
+			continue;
+		nd->loops[i]->OnLoop();
+		nd->loopDone[i] = nd->loops[i]->IsDone() ? 1 : 0;
+	}
+}
+bool TaskGraphScheduler::NodeComplete(NodeData & nd) {
+	switch (nd.kind) {
+		case Single:
+		case Deadline:
+			return nd.loopDone[0] != 0;
+		case Race:
+			for (auto done : nd.loopDone) {
+				if (done)
+					return true;
+			}
+			return false;
+		case Parallel:
+			for (auto done : nd.loopDone) {
+				if (done == 0)
+					return false;
+			}
+			return true;
+	}
+	return true;
+}
+void TaskGraphScheduler::Process() {
+	if (_started == false)
+		return;
+
+	if (_pool != nullptr) {
+		for (auto node : _running)
+			_pool->Submit(&TaskGraphScheduler::RunNode, &_nodes[node]);
+		_pool->Wait();
+	} else {
+		for (auto node : _running)
+			RunNode(&_nodes[node]);
+	}
+
+	/* Retire finished nodes on this thread, successors start right away
+	 * and get their first OnLoop next tick */
+	_finished.clear();
+	for (int i = 0; i < (int) _running.size();) {
+		Node node = _running[i];
+		NodeData & nd = _nodes[node];
+		if (NodeComplete(nd) == false) {
+			++i;
+			continue;
+		}
+		/* Race and deadline groups stop whatever is still going */
+		for (int j = 0; j < (int) nd.loops.size(); ++j) {
+			if (nd.loopDone[j] == 0) {
+				nd.loops[j]->OnStop();
+				nd.loopDone[j] = 1;
+			}
+		}
+		nd.state = Finished;
+		_running[i] = _running.back();
+		_running.pop_back();
+		_finished.push_back(node);
+	}
+	for (auto node : _finished) {
+		for (auto succ : _nodes[node].successors) {
+			if (--_nodes[succ].remaining == 0)
+				StartNode(succ);
+		}
+	}
+}
+/* ILoopable */
+void TaskGraphScheduler::OnStart() {
+	TaskGraphScheduler::Start();
+}
+void TaskGraphScheduler::OnLoop() {
+	TaskGraphScheduler::Process();
+}
+void TaskGraphScheduler::OnStop() {
+	TaskGraphScheduler::Stop();
+}
+bool TaskGraphScheduler::IsDone() {
+	/* Done once nothing is running and nothing more can start */
+	return _running.empty();
+}
+
+} // namespace Schedulers
+} // namespace Tasking
+} // namespace CTRE
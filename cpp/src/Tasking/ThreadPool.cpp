@@ -0,0 +1,119 @@
+#include "ctre/phoenix/Tasking/ThreadPool.h"
+
+namespace CTRE {
+namespace Tasking {
+
+ThreadPool::ThreadPool(int workerCount) {
+	if (workerCount < 1)
+		workerCount = 1;
+	_queued = 0;
+	_pending = 0;
+	_nextWorker = 0;
+	for (int i = 0; i < workerCount; ++i)
+		_workers.push_back(new Worker());
+	/* Start threads only once every queue exists, workers steal from all of them */
+	for (int i = 0; i < workerCount; ++i)
+		_workers[i]->thread = std::thread(&ThreadPool::WorkerLoop, this, i);
+}
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_sleepLock);
+		_stop = true;
+	}
+	_workCv.notify_all();
+	for (auto worker : _workers) {
+		if (worker->thread.joinable())
+			worker->thread.join();
+		delete worker;
+	}
+}
+int ThreadPool::GetWorkerCount() {
+	return (int) _workers.size();
+}
+/**
+ * Queue a task.
+ * @param worker	Preferred worker queue, -1 to round robin.  Another worker
+ * 					may still steal the task if the preferred one is busy.
+ */
+void ThreadPool::Submit(TaskFunc func, void *arg, int worker) {
+	int count = (int) _workers.size();
+	int idx = (worker >= 0) ? worker % count : (int) (_nextWorker++ % count);
+
+	++_pending;
+	{
+		std::lock_guard<std::mutex> lock(_workers[idx]->lock);
+		_workers[idx]->queue.push_back(Task{func, arg});
+	}
+	++_queued;
+	{
+		/* Pairs with the predicate check in WorkerLoop so the wakeup is not lost */
+		std::lock_guard<std::mutex> lock(_sleepLock);
+	}
+	_workCv.notify_one();
+}
+/**
+ * Block until every submitted task has finished.
+ * The calling thread runs queued tasks while it waits.
+ */
+void ThreadPool::Wait() {
+	Task task;
+	while (_pending.load() > 0) {
+		if (Steal(-1, task)) {
+			RunTask(task);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(_sleepLock);
+		_doneCv.wait(lock, [this] {return _pending.load() == 0 || _queued.load() > 0;});
+	}
+}
+bool ThreadPool::PopOwn(int idx, Task & task) {
+	Worker *w = _workers[idx];
+	std::lock_guard<std::mutex> lock(w->lock);
+	if (w->queue.empty())
+		return false;
+	task = w->queue.back();
+	w->queue.pop_back();
+	--_queued;
+	return true;
+}
+bool ThreadPool::Steal(int thief, Task & task) {
+	int count = (int) _workers.size();
+	int start = (thief >= 0) ? thief + 1 : 0;
+	for (int n = 0; n < count; ++n) {
+		int idx = (start + n) % count;
+		if (idx == thief)
+			continue;
+		Worker *w = _workers[idx];
+		std::lock_guard<std::mutex> lock(w->lock);
+		if (w->queue.empty())
+			continue;
+		task = w->queue.front();
+		w->queue.pop_front();
+		--_queued;
+		return true;
+	}
+	return false;
+}
+void ThreadPool::RunTask(const Task & task) {
+	task.func(task.arg);
+	if (--_pending == 0) {
+		std::lock_guard<std::mutex> lock(_sleepLock);
+		_doneCv.notify_all();
+	}
+}
+void ThreadPool::WorkerLoop(int idx) {
+	Task task;
+	for (;;) {
+		if (PopOwn(idx, task) || Steal(idx, task)) {
+			RunTask(task);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(_sleepLock);
+		_workCv.wait(lock, [this] {return _stop || _queued.load() > 0;});
+		if (_stop)
+			return;
+	}
+}
+
+} // namespace Tasking
+} // namespace CTRE
@@ -0,0 +1,307 @@
+#include "ctre/phoenix/Telemetry/CANTap.h"
+#include "ctre/phoenix/Timebase.h"
+#include "FRC_NetworkCommunication/CANSessionMux.h"
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+/* Resolve to the NI functions when linked with --wrap, otherwise null */
+extern "C" {
+void __real_FRC_NetworkCommunication_CANSessionMux_sendMessage(uint32_t messageID, const uint8_t *data,
+		uint8_t dataSize, int32_t periodMs, int32_t *status) __attribute__((weak));
+void __real_FRC_NetworkCommunication_CANSessionMux_receiveMessage(uint32_t *messageID, uint32_t messageIDMask,
+		uint8_t *data, uint8_t *dataSize, uint32_t *timeStamp, int32_t *status) __attribute__((weak));
+void __real_FRC_NetworkCommunication_CANSessionMux_readStreamSession(uint32_t sessionHandle,
+		struct tCANStreamMessage *messages, uint32_t messagesToRead, uint32_t *messagesRead, int32_t *status)
+		__attribute__((weak));
+}
+
+namespace CTRE { namespace Telemetry {
+
+static const uint32_t kRingSize = 4096; /* power of two */
+
+/* SocketCAN can_id flags */
+static const uint32_t kSocketCanEff = 0x80000000;
+static const uint32_t kSocketCanRtr = 0x40000000;
+static const uint32_t kLinkTypeSocketCan = 227;
+static const uint32_t kPcapFrameSize = 16;
+
+/* One captured frame, same slot protocol as the CTRLogger ring:
+ * free for the producer at position p when seq == p,
+ * ready for the writer when seq == p + 1. */
+struct TapFrame {
+	std::atomic<uint32_t> seq;
+	int64_t timestampNs;
+	uint32_t messageId; /* NI form, CAN_IS_FRAME_* flags included */
+	uint8_t length;
+	uint8_t data[8];
+};
+
+/* Outside the ring so the wrappers test it without the Ring() static guard,
+ * constant initialized so it is valid before any constructor runs */
+static std::atomic<bool> _running(false);
+
+struct TapRing {
+	TapFrame frames[kRingSize];
+	std::atomic<uint32_t> head;
+	uint32_t tail = 0; /* writer thread only */
+
+	std::atomic<uint64_t> txFrames;
+	std::atomic<uint64_t> rxFrames;
+	std::atomic<uint64_t> droppedFrames;
+	std::atomic<uint64_t> writtenFrames;
+
+	/* owned by Start/Stop and the writer */
+	std::mutex controlLock;
+	std::thread writer;
+	FILE *file = nullptr;
+	CANTap::Format format = CANTap::CandumpFormat;
+	char interfaceName[16];
+	int64_t startNs = 0;
+
+	TapRing() :
+			head(0), txFrames(0), rxFrames(0), droppedFrames(0), writtenFrames(0) {
+		for (uint32_t i = 0; i < kRingSize; ++i)
+			frames[i].seq.store(i, std::memory_order_relaxed);
+		interfaceName[0] = 0;
+	}
+	/* Stop() was never called, finish the capture so exit does not terminate */
+	~TapRing() {
+		if (file == nullptr)
+			return;
+		_running.store(false, std::memory_order_release);
+		if (writer.joinable())
+			writer.join();
+		fclose(file);
+		file = nullptr;
+	}
+};
+static TapRing & Ring() {
+	static TapRing ring;
+	return ring;
+}
+
+static void Push(uint32_t messageId, const uint8_t *data, uint8_t length, bool transmit) {
+	TapRing & ring = Ring();
+	if (length > 8)
+		length = 8;
+	(transmit ? ring.txFrames : ring.rxFrames).fetch_add(1, std::memory_order_relaxed);
+
+	/* Claim a slot, drop the frame rather than wait if the writer is behind */
+	uint32_t pos = ring.head.load(std::memory_order_relaxed);
+	TapFrame *frame;
+	for (;;) {
+		frame = &ring.frames[pos & (kRingSize - 1)];
+		int32_t diff = (int32_t) (frame->seq.load(std::memory_order_acquire) - pos);
+		if (diff == 0) {
+			if (ring.head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			ring.droppedFrames.fetch_add(1, std::memory_order_relaxed);
+			return;
+		} else {
+			pos = ring.head.load(std::memory_order_relaxed);
+		}
+	}
+	frame->timestampNs = Timebase::NowNs();
+	frame->messageId = messageId;
+	frame->length = length;
+	if (length > 0)
+		memcpy(frame->data, data, length);
+	frame->seq.store(pos + 1, std::memory_order_release);
+}
+
+static void WriteCandump(FILE *file, const char *interfaceName, const TapFrame & frame) {
+	int64_t us = frame.timestampNs / 1000;
+	uint32_t arbId = frame.messageId & ~(CAN_IS_FRAME_REMOTE | CAN_IS_FRAME_11BIT);
+	char line[64];
+	int n;
+	if (frame.messageId & CAN_IS_FRAME_11BIT)
+		n = snprintf(line, sizeof(line), "(%lld.%06lld) %s %03X#", (long long) (us / 1000000),
+				(long long) (us % 1000000), interfaceName, (unsigned) arbId);
+	else
+		n = snprintf(line, sizeof(line), "(%lld.%06lld) %s %08X#", (long long) (us / 1000000),
+				(long long) (us % 1000000), interfaceName, (unsigned) arbId);
+	if (n < 0 || n >= (int) sizeof(line) - 18)
+		return;
+	if (frame.messageId & CAN_IS_FRAME_REMOTE) {
+		line[n++] = 'R';
+	} else {
+		static const char kHex[] = "0123456789ABCDEF";
+		for (int i = 0; i < frame.length; ++i) {
+			line[n++] = kHex[frame.data[i] >> 4];
+			line[n++] = kHex[frame.data[i] & 0xF];
+		}
+	}
+	line[n++] = '\n';
+	fwrite(line, 1, n, file);
+}
+static void WritePcapHeader(FILE *file) {
+	uint32_t header[6];
+	header[0] = 0xA1B23C4D; /* nanosecond resolution, native byte order */
+	header[2] = 0; /* thiszone */
+	header[3] = 0; /* sigfigs */
+	header[4] = kPcapFrameSize; /* snaplen */
+	header[5] = kLinkTypeSocketCan;
+	uint16_t version[2] = { 2, 4 }; /* two native uint16 */
+	memcpy(&header[1], version, sizeof(version));
+	fwrite(header, 1, sizeof(header), file);
+}
+static void WritePcapFrame(FILE *file, const TapFrame & frame) {
+	uint32_t canId = frame.messageId & ~(CAN_IS_FRAME_REMOTE | CAN_IS_FRAME_11BIT);
+	if ((frame.messageId & CAN_IS_FRAME_11BIT) == 0)
+		canId |= kSocketCanEff;
+	if (frame.messageId & CAN_IS_FRAME_REMOTE)
+		canId |= kSocketCanRtr;
+
+	uint32_t record[4];
+	record[0] = (uint32_t) (frame.timestampNs / 1000000000);
+	record[1] = (uint32_t) (frame.timestampNs % 1000000000);
+	record[2] = kPcapFrameSize;
+	record[3] = kPcapFrameSize;
+
+	/* struct can_frame, can_id is big endian in LINKTYPE_CAN_SOCKETCAN */
+	uint8_t body[kPcapFrameSize];
+	memset(body, 0, sizeof(body));
+	body[0] = (uint8_t) (canId >> 24);
+	body[1] = (uint8_t) (canId >> 16);
+	body[2] = (uint8_t) (canId >> 8);
+	body[3] = (uint8_t) canId;
+	body[4] = frame.length;
+	if ((frame.messageId & CAN_IS_FRAME_REMOTE) == 0)
+		memcpy(body + 8, frame.data, frame.length);
+
+	fwrite(record, 1, sizeof(record), file);
+	fwrite(body, 1, sizeof(body), file);
+}
+
+/**
+ * Create the capture file and start mirroring frames into it.
+ * @param interfaceName	Interface name written on candump lines.
+ * @return false if the file cannot be created or a capture is already running.
+ */
+bool CANTap::Start(const std::string & path, Format format, const char *interfaceName) {
+	TapRing & ring = Ring();
+	std::lock_guard<std::mutex> lock(ring.controlLock);
+	if (ring.file != nullptr)
+		return false;
+	FILE *file = fopen(path.c_str(), (format == PcapFormat) ? "wb" : "w");
+	if (file == nullptr)
+		return false;
+	if (format == PcapFormat)
+		WritePcapHeader(file);
+
+	ring.file = file;
+	ring.format = format;
+	strncpy(ring.interfaceName, interfaceName, sizeof(ring.interfaceName) - 1);
+	ring.interfaceName[sizeof(ring.interfaceName) - 1] = 0;
+	/* Frames still in the ring from an earlier capture are older than this */
+	ring.startNs = Timebase::NowNs();
+	_running.store(true, std::memory_order_release);
+	ring.writer = std::thread(&CANTap::WriterLoop);
+	return true;
+}
+/**
+ * Stop mirroring, write out what is left in the ring and close the file.
+ */
+void CANTap::Stop() {
+	TapRing & ring = Ring();
+	std::lock_guard<std::mutex> lock(ring.controlLock);
+	if (ring.file == nullptr)
+		return;
+	_running.store(false, std::memory_order_release);
+	if (ring.writer.joinable())
+		ring.writer.join();
+	fclose(ring.file);
+	ring.file = nullptr;
+}
+/** True when the program was linked with the --wrap flags listed in CANTap.h. */
+bool CANTap::IsLinked() {
+	return &__real_FRC_NetworkCommunication_CANSessionMux_sendMessage != nullptr;
+}
+bool CANTap::IsRunning() {
+	return _running.load(std::memory_order_relaxed);
+}
+/**
+ * Mirror one frame, does nothing unless a capture is running.
+ * @param messageId	Arbitration ID with the NI CAN_IS_FRAME_REMOTE / CAN_IS_FRAME_11BIT flags.
+ */
+void CANTap::Record(uint32_t messageId, const uint8_t *data, uint8_t length, bool transmit) {
+	if (_running.load(std::memory_order_relaxed))
+		Push(messageId, data, length, transmit);
+}
+void CANTap::GetStats(Stats & stats) {
+	TapRing & ring = Ring();
+	stats.txFrames = ring.txFrames.load(std::memory_order_relaxed);
+	stats.rxFrames = ring.rxFrames.load(std::memory_order_relaxed);
+	stats.droppedFrames = ring.droppedFrames.load(std::memory_order_relaxed);
+	stats.writtenFrames = ring.writtenFrames.load(std::memory_order_relaxed);
+}
+void CANTap::ResetStats() {
+	TapRing & ring = Ring();
+	ring.txFrames.store(0, std::memory_order_relaxed);
+	ring.rxFrames.store(0, std::memory_order_relaxed);
+	ring.droppedFrames.store(0, std::memory_order_relaxed);
+	ring.writtenFrames.store(0, std::memory_order_relaxed);
+}
+void CANTap::WriterLoop() {
+	TapRing & ring = Ring();
+	for (;;) {
+		bool running = _running.load(std::memory_order_acquire);
+		/* Drain everything published so far */
+		for (;;) {
+			TapFrame & frame = ring.frames[ring.tail & (kRingSize - 1)];
+			if (frame.seq.load(std::memory_order_acquire) != ring.tail + 1)
+				break;
+			if (frame.timestampNs >= ring.startNs) {
+				if (ring.format == PcapFormat)
+					WritePcapFrame(ring.file, frame);
+				else
+					WriteCandump(ring.file, ring.interfaceName, frame);
+				ring.writtenFrames.fetch_add(1, std::memory_order_relaxed);
+			}
+			frame.seq.store(ring.tail + kRingSize, std::memory_order_release);
+			++ring.tail;
+		}
+		if (running == false)
+			break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	fflush(ring.file);
+}
+
+}}
+
+/*
+ * Link time wrappers, see CANTap.h.  The __real_ references above are weak so
+ * the library still links when the --wrap flags are not given.
+ */
+extern "C" {
+
+void __wrap_FRC_NetworkCommunication_CANSessionMux_sendMessage(uint32_t messageID, const uint8_t *data,
+		uint8_t dataSize, int32_t periodMs, int32_t *status) {
+	__real_FRC_NetworkCommunication_CANSessionMux_sendMessage(messageID, data, dataSize, periodMs, status);
+	if (CTRE::Telemetry::_running.load(std::memory_order_relaxed)
+			&& *status == 0 && periodMs != CAN_SEND_PERIOD_STOP_REPEATING)
+		CTRE::Telemetry::Push(messageID, data, dataSize, true);
+}
+void __wrap_FRC_NetworkCommunication_CANSessionMux_receiveMessage(uint32_t *messageID, uint32_t messageIDMask,
+		uint8_t *data, uint8_t *dataSize, uint32_t *timeStamp, int32_t *status) {
+	__real_FRC_NetworkCommunication_CANSessionMux_receiveMessage(messageID, messageIDMask, data, dataSize,
+			timeStamp, status);
+	if (CTRE::Telemetry::_running.load(std::memory_order_relaxed) && *status == 0)
+		CTRE::Telemetry::Push(*messageID, data, *dataSize, false);
+}
+void __wrap_FRC_NetworkCommunication_CANSessionMux_readStreamSession(uint32_t sessionHandle,
+		struct tCANStreamMessage *messages, uint32_t messagesToRead, uint32_t *messagesRead, int32_t *status) {
+	__real_FRC_NetworkCommunication_CANSessionMux_readStreamSession(sessionHandle, messages, messagesToRead,
+			messagesRead, status);
+	if (CTRE::Telemetry::_running.load(std::memory_order_relaxed) && *status == 0)
+		for (uint32_t i = 0; i < *messagesRead; ++i)
+			CTRE::Telemetry::Push(messages[i].messageID, messages[i].data, messages[i].dataSize, false);
+}
+
+}
@@ -0,0 +1,43 @@
+#include "ctre/phoenix/Telemetry/ControlLog.h"
+#include "ctre/phoenix/Timebase.h"
+
+namespace CTRE { namespace Telemetry {
+
+ControlLog::~ControlLog() {
+	Close();
+}
+/**
+ * @param timestamps	Leave out the timestamp column when runs should only
+ * 						be compared by the order of demands.
+ */
+bool ControlLog::Open(const std::string & path, bool timestamps) {
+	Close();
+	std::lock_guard<std::mutex> lock(_lock);
+	_file = fopen(path.c_str(), "w");
+	_timestamps = timestamps;
+	_count = 0;
+	return _file != nullptr;
+}
+void ControlLog::Close() {
+	std::lock_guard<std::mutex> lock(_lock);
+	if (_file != nullptr)
+		fclose(_file);
+	_file = nullptr;
+}
+void ControlLog::Record(int arbId, int mode, int demand0, int demand1) {
+	int64_t now = Timebase::NowNs();
+	std::lock_guard<std::mutex> lock(_lock);
+	if (_file == nullptr)
+		return;
+	if (_timestamps)
+		fprintf(_file, "%lld %08X %d %d %d\n", (long long) now, arbId, mode, demand0, demand1);
+	else
+		fprintf(_file, "%08X %d %d %d\n", arbId, mode, demand0, demand1);
+	++_count;
+}
+uint32_t ControlLog::GetCount() {
+	std::lock_guard<std::mutex> lock(_lock);
+	return _count;
+}
+
+}}
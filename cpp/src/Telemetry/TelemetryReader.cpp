@@ -0,0 +1,226 @@
+#include "ctre/phoenix/Telemetry/TelemetryReader.h"
+#include <algorithm>
+#include <atomic>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+
+namespace CTRE { namespace Telemetry {
+
+static bool ReadAt(int fd, void *buf, size_t length, int64_t offset) {
+	char *p = (char *) buf;
+	while (length > 0) {
+		ssize_t n = pread(fd, p, length, (off_t) offset);
+		if (n <= 0)
+			return false;
+		p += n;
+		offset += n;
+		length -= (size_t) n;
+	}
+	return true;
+}
+
+TelemetryReader::TelemetryReader() {
+}
+TelemetryReader::~TelemetryReader() {
+	Close();
+}
+/**
+ * Read the signal table and index every block.  Only headers are read.
+ * A truncated last block (recording cut off mid-write) is ignored.
+ * @return false if the file is missing or not a telemetry file.
+ */
+bool TelemetryReader::Open(const std::string & path) {
+	Close();
+	_fd = open(path.c_str(), O_RDONLY);
+	if (_fd < 0)
+		return false;
+	int64_t fileLength = (int64_t) lseek(_fd, 0, SEEK_END);
+
+	TelemetryFileHeader header;
+	if (ReadAt(_fd, &header, sizeof(header), 0) == false || memcmp(header.magic, kTelemetryMagic, sizeof(header.magic)) != 0
+			|| header.version != kTelemetryVersion) {
+		Close();
+		return false;
+	}
+	_signals.resize(header.signalCount);
+	int64_t offset = sizeof(header);
+	if (header.signalCount > 0
+			&& ReadAt(_fd, _signals.data(), sizeof(TelemetrySignalDesc) * header.signalCount, offset) == false) {
+		Close();
+		return false;
+	}
+	offset += sizeof(TelemetrySignalDesc) * header.signalCount;
+
+	std::vector<uint32_t> columnBytes(header.signalCount);
+	while (offset + (int64_t) sizeof(TelemetryBlockHeader) <= fileLength) {
+		TelemetryBlockHeader bh;
+		if (ReadAt(_fd, &bh, sizeof(bh), offset) == false || bh.magic != kTelemetryBlockMagic
+				|| bh.signalCount != header.signalCount)
+			break;
+		offset += sizeof(bh);
+		if (bh.signalCount > 0 && ReadAt(_fd, columnBytes.data(), sizeof(uint32_t) * bh.signalCount, offset) == false)
+			break;
+		offset += sizeof(uint32_t) * bh.signalCount;
+
+		BlockIndex block;
+		block.firstTimestampNs = bh.firstTimestampNs;
+		block.lastTimestampNs = bh.lastTimestampNs;
+		block.rows = bh.rowCount;
+		block.timeOffset = offset;
+		block.timeBytes = bh.timeBytes;
+		offset += bh.timeBytes;
+		for (uint32_t s = 0; s < bh.signalCount; ++s) {
+			block.columnOffsets.push_back(offset);
+			block.columnBytes.push_back(columnBytes[s]);
+			offset += columnBytes[s];
+		}
+		if (offset > fileLength)
+			break;
+		_blocks.push_back(block);
+	}
+	return true;
+}
+void TelemetryReader::Close() {
+	if (_fd >= 0)
+		close(_fd);
+	_fd = -1;
+	_signals.clear();
+	_blocks.clear();
+}
+int TelemetryReader::GetSignalCount() {
+	return (int) _signals.size();
+}
+const TelemetrySignalDesc & TelemetryReader::GetSignal(int index) {
+	return _signals[index];
+}
+/**
+ * @param deviceNumber	CAN device number, motor controllers match on the low six bits of their arbitration id.
+ * @return signal index, -1 if not recorded.
+ */
+int TelemetryReader::FindSignal(TelemetryDeviceType type, int deviceNumber, const char *name) {
+	for (unsigned int i = 0; i < _signals.size(); ++i) {
+		const TelemetrySignalDesc & s = _signals[i];
+		if (s.deviceType != (uint32_t) type)
+			continue;
+		int number = (type == MotorControllerDevice) ? (s.deviceId & 0x3F) : s.deviceId;
+		if (number == deviceNumber && strncmp(s.name, name, sizeof(s.name)) == 0)
+			return (int) i;
+	}
+	return -1;
+}
+int TelemetryReader::GetBlockCount() {
+	return (int) _blocks.size();
+}
+int64_t TelemetryReader::GetStartNs() {
+	return _blocks.empty() ? 0 : _blocks.front().firstTimestampNs;
+}
+int64_t TelemetryReader::GetEndNs() {
+	return _blocks.empty() ? 0 : _blocks.back().lastTimestampNs;
+}
+bool TelemetryReader::DecodeBlock(const BlockIndex & block, int signal, int64_t startNs, int64_t endNs,
+		std::vector<Sample> & samples) {
+	std::vector<uint8_t> time(block.timeBytes);
+	std::vector<uint8_t> column(block.columnBytes[signal]);
+	if (ReadAt(_fd, time.data(), time.size(), block.timeOffset) == false
+			|| ReadAt(_fd, column.data(), column.size(), block.columnOffsets[signal]) == false)
+		return false;
+
+	const uint8_t *tp = time.data();
+	const uint8_t *tend = tp + time.size();
+	const uint8_t *cp = column.data();
+	const uint8_t *cend = cp + column.size();
+	bool isInteger = (_signals[signal].kind == IntegerSignal);
+	TimeCodec timeCodec;
+	IntegerCodec intCodec;
+	FloatCodec floatCodec;
+
+	for (uint32_t r = 0; r < block.rows; ++r) {
+		Sample sample;
+		tp = timeCodec.Decode(tp, tend, sample.timestampNs);
+		if (tp == nullptr)
+			return false;
+		/* Values are deltas, every row has to be decoded even outside the range */
+		if (isInteger) {
+			int32_t v = 0;
+			cp = intCodec.Decode(cp, cend, v);
+			sample.value = v;
+		} else {
+			float v = 0;
+			cp = floatCodec.Decode(cp, cend, v);
+			sample.value = v;
+		}
+		if (cp == nullptr)
+			return false;
+		if (sample.timestampNs > endNs)
+			break;
+		if (sample.timestampNs >= startNs)
+			samples.push_back(sample);
+	}
+	return true;
+}
+/**
+ * Every sample of one signal with startNs <= timestamp <= endNs, in time order.
+ * @param threads	Decode threads, 0 for one per core.
+ * @return false if a block could not be read or decoded.
+ */
+bool TelemetryReader::Query(int signal, int64_t startNs, int64_t endNs, std::vector<Sample> & samples, int threads) {
+	samples.clear();
+	if (signal < 0 || signal >= (int) _signals.size())
+		return false;
+
+	/* Blocks are written in time order, so the overlap is one contiguous run */
+	auto first = std::lower_bound(_blocks.begin(), _blocks.end(), startNs,
+			[](const BlockIndex & b, int64_t t) { return b.lastTimestampNs < t; });
+	auto last = std::upper_bound(first, _blocks.end(), endNs,
+			[](int64_t t, const BlockIndex & b) { return t < b.firstTimestampNs; });
+	int begin = (int) (first - _blocks.begin());
+	int count = (int) (last - first);
+	if (count <= 0)
+		return true;
+
+	std::vector<std::vector<Sample> > perBlock(count);
+	std::atomic<int> next(0);
+	std::atomic<bool> ok(true);
+	auto worker = [&]() {
+		for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+			if (DecodeBlock(_blocks[begin + i], signal, startNs, endNs, perBlock[i]) == false)
+				ok = false;
+		}
+	};
+
+	if (threads <= 0)
+		threads = (int) std::thread::hardware_concurrency();
+	if (threads > count)
+		threads = count;
+	std::vector<std::thread> pool;
+	for (int t = 1; t < threads; ++t)
+		pool.emplace_back(worker);
+	worker();
+	for (auto & th : pool)
+		th.join();
+
+	size_t total = 0;
+	for (auto & v : perBlock)
+		total += v.size();
+	samples.reserve(total);
+	for (auto & v : perBlock)
+		samples.insert(samples.end(), v.begin(), v.end());
+	return ok;
+}
+/**
+ * Like Query() but only the first sample and the samples whose value differs
+ * from the row before, e.g. state transitions or flags being set.
+ */
+bool TelemetryReader::QueryChanges(int signal, int64_t startNs, int64_t endNs, std::vector<Sample> & samples, int threads) {
+	std::vector<Sample> all;
+	bool ok = Query(signal, startNs, endNs, all, threads);
+	samples.clear();
+	for (unsigned int i = 0; i < all.size(); ++i) {
+		if (i == 0 || all[i].value != all[i - 1].value)
+			samples.push_back(all[i]);
+	}
+	return ok;
+}
+
+}}
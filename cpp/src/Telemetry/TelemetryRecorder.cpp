@@ -0,0 +1,345 @@
+#include "ctre/phoenix/Telemetry/TelemetryRecorder.h"
+#include "ctre/phoenix/Timebase.h"
+
+namespace CTRE { namespace Telemetry {
+
+TelemetryRecorder::TelemetryRecorder(int rowsPerBlock, int blockCount) :
+		_rows(0), _droppedRows(0), _blocksWritten(0), _bytes(0), _threadRunning(false) {
+	_rowsPerBlock = (rowsPerBlock > 0) ? rowsPerBlock : 1;
+	_blockCount = (blockCount > 1) ? blockCount : 2;
+}
+TelemetryRecorder::~TelemetryRecorder() {
+	StopThread();
+	Stop();
+	for (auto block : _blocks)
+		delete block;
+}
+void TelemetryRecorder::AddSignal(TelemetryDeviceType type, int32_t deviceId, TelemetrySignalKind kind, const char *name) {
+	TelemetrySignalDesc desc;
+	memset(&desc, 0, sizeof(desc));
+	desc.deviceType = type;
+	desc.deviceId = deviceId;
+	desc.kind = kind;
+	strncpy(desc.name, name, sizeof(desc.name) - 1);
+	_signals.push_back(desc);
+}
+/**
+ * Record position, velocity, current, bus voltage, output and temperature.
+ * @return false while recording, the row layout is fixed by Start().
+ */
+bool TelemetryRecorder::Add(CTRE::MotorControl::IMotorController *motorController) {
+	if (_file != nullptr)
+		return false;
+	Device d = { MotorControllerDevice, motorController };
+	_devices.push_back(d);
+	int32_t id = motorController->GetBaseID();
+	AddSignal(MotorControllerDevice, id, IntegerSignal, "Position");
+	AddSignal(MotorControllerDevice, id, IntegerSignal, "Velocity");
+	AddSignal(MotorControllerDevice, id, FloatSignal, "OutputCurrent");
+	AddSignal(MotorControllerDevice, id, FloatSignal, "BusVoltage");
+	AddSignal(MotorControllerDevice, id, FloatSignal, "OutputPercent");
+	AddSignal(MotorControllerDevice, id, FloatSignal, "Temperature");
+	return true;
+}
+/**
+ * Record yaw, pitch, roll, raw gyro rates and state.
+ * @return false while recording.
+ */
+bool TelemetryRecorder::Add(CTRE::PigeonIMU *pigeon) {
+	if (_file != nullptr)
+		return false;
+	Device d = { PigeonDevice, pigeon };
+	_devices.push_back(d);
+	int32_t id = pigeon->GetDeviceNumber();
+	AddSignal(PigeonDevice, id, FloatSignal, "Yaw");
+	AddSignal(PigeonDevice, id, FloatSignal, "Pitch");
+	AddSignal(PigeonDevice, id, FloatSignal, "Roll");
+	AddSignal(PigeonDevice, id, FloatSignal, "GyroX");
+	AddSignal(PigeonDevice, id, FloatSignal, "GyroY");
+	AddSignal(PigeonDevice, id, FloatSignal, "GyroZ");
+	AddSignal(PigeonDevice, id, IntegerSignal, "State");
+	return true;
+}
+/**
+ * Record the general inputs (one bit per GeneralPin) and all four PWM inputs.
+ * @return false while recording.
+ */
+bool TelemetryRecorder::Add(CTRE::CANifier *canifier) {
+	if (_file != nullptr)
+		return false;
+	Device d = { CANifierDevice, canifier };
+	_devices.push_back(d);
+	int32_t id = canifier->GetDeviceNumber();
+	AddSignal(CANifierDevice, id, IntegerSignal, "GeneralInputs");
+	static const char * const pwmNames[8] = { "PWM0Duty", "PWM0Period", "PWM1Duty", "PWM1Period",
+			"PWM2Duty", "PWM2Period", "PWM3Duty", "PWM3Period" };
+	for (int i = 0; i < 8; ++i)
+		AddSignal(CANifierDevice, id, FloatSignal, pwmNames[i]);
+	return true;
+}
+int TelemetryRecorder::GetSignalCount() {
+	return (int) _signals.size();
+}
+const TelemetrySignalDesc & TelemetryRecorder::GetSignal(int index) {
+	return _signals[index];
+}
+/**
+ * Create the file, write the signal table and start the writer thread.
+ * @return false if the file cannot be created or recording already started.
+ */
+bool TelemetryRecorder::Start(const std::string & path) {
+	if (_file != nullptr)
+		return false;
+	FILE *file = fopen(path.c_str(), "wb");
+	if (file == nullptr)
+		return false;
+
+	TelemetryFileHeader header;
+	memcpy(header.magic, kTelemetryMagic, sizeof(header.magic));
+	header.version = kTelemetryVersion;
+	header.signalCount = (uint32_t) _signals.size();
+	fwrite(&header, sizeof(header), 1, file);
+	if (_signals.empty() == false)
+		fwrite(_signals.data(), sizeof(TelemetrySignalDesc), _signals.size(), file);
+	_bytes = sizeof(header) + sizeof(TelemetrySignalDesc) * _signals.size();
+
+	/* Allocate every block up front, sampling never allocates */
+	for (auto block : _blocks)
+		delete block;
+	_blocks.clear();
+	_free.clear();
+	_full.clear();
+	for (int b = 0; b < _blockCount; ++b) {
+		Block *block = new Block();
+		block->time.bytes.resize((size_t) _rowsPerBlock * kMaxTimeBytes);
+		block->columns.resize(_signals.size());
+		for (unsigned int s = 0; s < _signals.size(); ++s) {
+			int perRow = (_signals[s].kind == IntegerSignal) ? kMaxIntegerBytes : kMaxFloatBytes;
+			block->columns[s].bytes.resize((size_t) _rowsPerBlock * perRow);
+		}
+		_blocks.push_back(block);
+		_free.push_back(block);
+	}
+	_row.resize(_signals.size());
+	_intCodecs.resize(_signals.size());
+	_floatCodecs.resize(_signals.size());
+	_current = nullptr;
+
+	_file = file;
+	_writing = true;
+	_writer = std::thread(&TelemetryRecorder::WriterLoop, this);
+	return true;
+}
+/**
+ * Write out the partial block, wait for the writer to finish and close the file.
+ */
+void TelemetryRecorder::Stop() {
+	if (_file == nullptr)
+		return;
+	if (_current != nullptr && _current->rows > 0)
+		SealBlock();
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		_writing = false;
+	}
+	_fullReady.notify_one();
+	if (_writer.joinable())
+		_writer.join();
+	fclose(_file);
+	_file = nullptr;
+	_current = nullptr;
+}
+void TelemetryRecorder::ReadRow() {
+	int s = 0;
+	for (auto & d : _devices) {
+		switch (d.type) {
+			case MotorControllerDevice: {
+				auto *mc = (CTRE::MotorControl::IMotorController *) d.device;
+				_row[s++].i = mc->GetSelectedSensorPosition();
+				_row[s++].i = mc->GetSelectedSensorVelocity();
+				mc->GetOutputCurrent(_row[s++].f);
+				mc->GetBusVoltage(_row[s++].f);
+				mc->GetMotorOutputPercent(_row[s++].f);
+				mc->GetTemperature(_row[s++].f);
+				break;
+			}
+			case PigeonDevice: {
+				auto *pigeon = (CTRE::PigeonIMU *) d.device;
+				double ypr[3];
+				double xyz[3];
+				pigeon->GetYawPitchRoll(ypr);
+				pigeon->GetRawGyro(xyz);
+				for (int i = 0; i < 3; ++i)
+					_row[s++].f = (float) ypr[i];
+				for (int i = 0; i < 3; ++i)
+					_row[s++].f = (float) xyz[i];
+				_row[s++].i = (int32_t) pigeon->GetState();
+				break;
+			}
+			case CANifierDevice: {
+				auto *canifier = (CTRE::CANifier *) d.device;
+				CTRE::CANifier::PinValues pins;
+				canifier->GetGeneralInputs(pins);
+				/* one bit per GeneralPin */
+				_row[s++].i = (pins.QUAD_IDX << CTRE::CANifier::QUAD_IDX) | (pins.QUAD_B << CTRE::CANifier::QUAD_B)
+						| (pins.QUAD_A << CTRE::CANifier::QUAD_A) | (pins.LIMR << CTRE::CANifier::LIMR)
+						| (pins.LIMF << CTRE::CANifier::LIMF) | (pins.SDA << CTRE::CANifier::SDA)
+						| (pins.SCL << CTRE::CANifier::SCL) | (pins.SPI_CS_PWM3 << CTRE::CANifier::SPI_CS)
+						| (pins.SPI_MISO_PWM2 << CTRE::CANifier::SPI_MISO_PWM2P)
+						| (pins.SPI_MOSI_PWM1 << CTRE::CANifier::SPI_MOSI_PWM1P)
+						| (pins.SPI_CLK_PWM0 << CTRE::CANifier::SPI_CLK_PWM0P);
+				for (int ch = 0; ch < 4; ++ch) {
+					float dutyCycleAndPeriod[2] = { 0, 0 };
+					canifier->GetPWMInput((CTRE::CANifier::PWMChannel) ch, dutyCycleAndPeriod);
+					_row[s++].f = dutyCycleAndPeriod[0];
+					_row[s++].f = dutyCycleAndPeriod[1];
+				}
+				break;
+			}
+		}
+	}
+}
+void TelemetryRecorder::BeginBlock() {
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		if (_free.empty())
+			return;
+		_current = _free.front();
+		_free.pop_front();
+	}
+	_current->rows = 0;
+	_current->time.used = 0;
+	for (auto & column : _current->columns)
+		column.used = 0;
+	/* Each block decodes on its own */
+	_timeCodec = TimeCodec();
+	for (auto & codec : _intCodecs)
+		codec = IntegerCodec();
+	for (auto & codec : _floatCodecs)
+		codec = FloatCodec();
+}
+void TelemetryRecorder::SealBlock() {
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		_full.push_back(_current);
+	}
+	_current = nullptr;
+	_fullReady.notify_one();
+}
+/**
+ * Read every signal now and append one row.
+ */
+void TelemetryRecorder::Sample() {
+	if (_file == nullptr)
+		return;
+	if (_current == nullptr) {
+		BeginBlock();
+		if (_current == nullptr) {
+			_droppedRows.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+	ReadRow();
+	int64_t now = Timebase::NowNs();
+
+	Block & b = *_current;
+	if (b.rows == 0)
+		b.firstTimestampNs = now;
+	b.lastTimestampNs = now;
+	b.time.used += _timeCodec.Encode(&b.time.bytes[b.time.used], now);
+	for (unsigned int s = 0; s < _signals.size(); ++s) {
+		Column & column = b.columns[s];
+		if (_signals[s].kind == IntegerSignal)
+			column.used += _intCodecs[s].Encode(&column.bytes[column.used], _row[s].i);
+		else
+			column.used += _floatCodecs[s].Encode(&column.bytes[column.used], _row[s].f);
+	}
+	++b.rows;
+	_rows.fetch_add(1, std::memory_order_relaxed);
+
+	if ((int) b.rows >= _rowsPerBlock)
+		SealBlock();
+}
+void TelemetryRecorder::WriteBlock(Block *block) {
+	TelemetryBlockHeader header;
+	header.magic = kTelemetryBlockMagic;
+	header.rowCount = block->rows;
+	header.firstTimestampNs = block->firstTimestampNs;
+	header.lastTimestampNs = block->lastTimestampNs;
+	header.timeBytes = block->time.used;
+	header.signalCount = (uint32_t) block->columns.size();
+
+	uint64_t bytes = sizeof(header) + block->time.used;
+	fwrite(&header, sizeof(header), 1, _file);
+	for (auto & column : block->columns) {
+		fwrite(&column.used, sizeof(column.used), 1, _file);
+		bytes += sizeof(column.used) + column.used;
+	}
+	fwrite(block->time.bytes.data(), 1, block->time.used, _file);
+	for (auto & column : block->columns)
+		fwrite(column.bytes.data(), 1, column.used, _file);
+
+	_bytes.fetch_add(bytes, std::memory_order_relaxed);
+	_blocksWritten.fetch_add(1, std::memory_order_relaxed);
+}
+void TelemetryRecorder::WriterLoop() {
+	std::unique_lock<std::mutex> lock(_lock);
+	for (;;) {
+		_fullReady.wait(lock, [this] { return _full.empty() == false || _writing == false; });
+		if (_full.empty()) {
+			/* Stopped and drained */
+			break;
+		}
+		Block *block = _full.front();
+		_full.pop_front();
+
+		lock.unlock();
+		WriteBlock(block);
+		lock.lock();
+		_free.push_back(block);
+	}
+	fflush(_file);
+}
+void TelemetryRecorder::GetStats(Stats & stats) {
+	stats.rows = _rows.load(std::memory_order_relaxed);
+	stats.droppedRows = _droppedRows.load(std::memory_order_relaxed);
+	stats.blocks = _blocksWritten.load(std::memory_order_relaxed);
+	stats.bytes = _bytes.load(std::memory_order_relaxed);
+}
+/**
+ * Sample on a dedicated thread every periodUs, against absolute deadlines.
+ */
+bool TelemetryRecorder::StartThread(int periodUs) {
+	if (_threadRunning.exchange(true) == true)
+		return false;
+	_thread = std::thread(&TelemetryRecorder::ThreadLoop, this, periodUs);
+	return true;
+}
+void TelemetryRecorder::StopThread() {
+	if (_threadRunning.exchange(false) == false)
+		return;
+	if (_thread.joinable())
+		_thread.join();
+}
+void TelemetryRecorder::ThreadLoop(int periodUs) {
+	int64_t period = (int64_t) periodUs * 1000;
+	int64_t next = Timebase::NowNs();
+	while (_threadRunning.load(std::memory_order_relaxed)) {
+		Sample();
+		next += period;
+		Timebase::SleepUntilNs(next);
+	}
+}
+/* ILoopable */
+void TelemetryRecorder::OnStart() {
+}
+void TelemetryRecorder::OnLoop() {
+	Sample();
+}
+bool TelemetryRecorder::IsDone() {
+	return false;
+}
+void TelemetryRecorder::OnStop() {
+}
+
+}}
@@ -0,0 +1,143 @@
+#include "ctre/phoenix/Telemetry/TelemetryReplay.h"
+#include "ctre/phoenix/MotorControl/CAN/BaseMotorController.h"
+#include <limits>
+
+namespace CTRE { namespace Telemetry {
+
+TelemetryReplay::TelemetryReplay(CTRE::DeviceCache *cache, CTRE::ManualClock *clock) {
+	_cache = cache;
+	_clock = clock;
+}
+/* Match a recorded signal to a device registered in the cache */
+bool TelemetryReplay::Bind(const TelemetrySignalDesc & signal, Binding & binding) {
+	static const char * const pigeonNames[] = { "Yaw", "Pitch", "Roll", "GyroX", "GyroY", "GyroZ", "State" };
+	static const char * const motorNames[] = { "Position", "Velocity", "OutputCurrent", "BusVoltage", "OutputPercent", "Temperature" };
+
+	if (signal.deviceType == PigeonDevice) {
+		for (int h = 0; h < _cache->GetPigeonCount(); ++h) {
+			if (_cache->GetPigeonDevice(h)->GetDeviceNumber() != signal.deviceId)
+				continue;
+			for (int n = 0; n < 7; ++n) {
+				if (strncmp(signal.name, pigeonNames[n], sizeof(signal.name)) == 0) {
+					binding.target = (Target) (PigeonYaw + n);
+					binding.handle = h;
+					return true;
+				}
+			}
+		}
+	} else if (signal.deviceType == MotorControllerDevice) {
+		for (int h = 0; h < _cache->GetMotorCount(); ++h) {
+			if (_cache->GetMotorDevice(h)->GetBaseID() != signal.deviceId)
+				continue;
+			for (int n = 0; n < 6; ++n) {
+				if (strncmp(signal.name, motorNames[n], sizeof(signal.name)) == 0) {
+					binding.target = (Target) (MotorPosition + n);
+					binding.handle = h;
+					return true;
+				}
+			}
+		}
+	}
+	/* CANifiers and devices not in the cache are skipped */
+	return false;
+}
+/**
+ * Decode every recorded signal that matches a device in the cache and
+ * switch the cache and every motor controller into replay, after which
+ * Set() no longer reaches the motors.  Register the devices with the cache first.
+ * @return false if a block could not be decoded.
+ */
+bool TelemetryReplay::Load(TelemetryReader & reader, int threads) {
+	_times.clear();
+	_bindings.clear();
+	_row = 0;
+
+	const int64_t all = std::numeric_limits<int64_t>::max();
+	std::vector<TelemetryReader::Sample> samples;
+	bool ok = true;
+	for (int s = 0; s < reader.GetSignalCount(); ++s) {
+		Binding binding;
+		bool bound = Bind(reader.GetSignal(s), binding);
+		/* Every column has a value per row, so any column gives the row times */
+		if (bound == false && _times.empty() == false)
+			continue;
+		if (reader.Query(s, std::numeric_limits<int64_t>::min(), all, samples, threads) == false)
+			ok = false;
+		if (_times.empty()) {
+			_times.reserve(samples.size());
+			for (auto & sample : samples)
+				_times.push_back(sample.timestampNs);
+		}
+		if (bound) {
+			binding.values.reserve(samples.size());
+			for (auto & sample : samples)
+				binding.values.push_back(sample.value);
+			/* a truncated recording can leave columns one row short */
+			binding.values.resize(_times.size(), binding.values.empty() ? 0 : binding.values.back());
+			_bindings.push_back(binding);
+		}
+	}
+	_cache->SetReplay(true);
+	CTRE::MotorControl::CAN::BaseMotorController::SetReplay(true);
+	return ok;
+}
+void TelemetryReplay::Apply(const Binding & binding, double value) {
+	if (binding.target <= PigeonState) {
+		CTRE::DeviceCache::PigeonSnapshot & p = _cache->_pigeons[binding.handle];
+		switch (binding.target) {
+			case PigeonYaw: p.ypr[0] = value; break;
+			case PigeonPitch: p.ypr[1] = value; break;
+			case PigeonRoll: p.ypr[2] = value; break;
+			case PigeonGyroX: p.rawGyro[0] = value; break;
+			case PigeonGyroY: p.rawGyro[1] = value; break;
+			case PigeonGyroZ: p.rawGyro[2] = value; break;
+			default: p.state = (CTRE::PigeonIMU::PigeonState) (int) value; break;
+		}
+		p.yprError = 0;
+		p.gyroError = 0;
+	} else {
+		CTRE::DeviceCache::MotorSnapshot & m = _cache->_motors[binding.handle];
+		switch (binding.target) {
+			case MotorPosition: m.position = (int) value; break;
+			case MotorVelocity: m.velocity = (int) value; break;
+			case MotorCurrent: m.outputCurrent = (float) value; break;
+			case MotorBusVoltage: m.busVoltage = (float) value; break;
+			case MotorOutputPercent: m.outputPercent = (float) value; break;
+			default: m.temperature = (float) value; break;
+		}
+	}
+}
+/**
+ * Load the next recorded row into the cache and move time to its timestamp.
+ * @return false once every row has been played.
+ */
+bool TelemetryReplay::Step() {
+	if (_row >= (int) _times.size())
+		return false;
+	int64_t t = _times[_row];
+	if (_clock != nullptr) {
+		_clock->SetNs(t);
+	} else {
+		if (_row == 0)
+			_wallStartNs = Timebase::NowNs();
+		Timebase::SleepUntilNs(_wallStartNs + (t - _times[0]));
+	}
+	for (auto & binding : _bindings)
+		Apply(binding, binding.values[_row]);
+	++_row;
+	return true;
+}
+void TelemetryReplay::Rewind() {
+	_row = 0;
+}
+int TelemetryReplay::GetRowCount() {
+	return (int) _times.size();
+}
+int TelemetryReplay::GetRowIndex() {
+	return _row;
+}
+int TelemetryReplay::GetBoundSignalCount() {
+	return (int) _bindings.size();
+}
+
+}}
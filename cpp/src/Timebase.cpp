@@ -0,0 +1,61 @@
+#include "ctre/phoenix/Timebase.h"
+#include <time.h>
+#include <errno.h>
+
+namespace CTRE {
+
+int64_t MonotonicClock::NowNs(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+void MonotonicClock::SleepUntilNs(int64_t ns){
+	struct timespec ts;
+	ts.tv_sec = (time_t)(ns / 1000000000LL);
+	ts.tv_nsec = (long)(ns % 1000000000LL);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+	}
+}
+
+ManualClock::ManualClock(int64_t startNs){
+	_now = startNs;
+}
+int64_t ManualClock::NowNs(){
+	return _now.load(std::memory_order_acquire);
+}
+void ManualClock::SleepUntilNs(int64_t ns){
+	int64_t now = _now.load(std::memory_order_acquire);
+	while (now < ns && !_now.compare_exchange_weak(now, ns)) {
+	}
+}
+void ManualClock::SetNs(int64_t ns){
+	_now.store(ns, std::memory_order_release);
+}
+void ManualClock::AdvanceNs(int64_t ns){
+	_now.fetch_add(ns);
+}
+
+static MonotonicClock _monotonic;
+static std::atomic<IClockSource*> _source(&_monotonic);
+
+int64_t Timebase::NowNs(){
+	return _source.load(std::memory_order_acquire)->NowNs();
+}
+double Timebase::NowSeconds(){
+	return NowNs() * 1e-9;
+}
+void Timebase::SleepUntilNs(int64_t ns){
+	_source.load(std::memory_order_acquire)->SleepUntilNs(ns);
+}
+/**
+ * @param source	Clock to use from now on, nullptr to go back to CLOCK_MONOTONIC.
+ * 					Must outlive its use.
+ */
+void Timebase::SetClockSource(IClockSource *source){
+	_source.store((source != nullptr) ? source : &_monotonic, std::memory_order_release);
+}
+IClockSource * Timebase::GetClockSource(){
+	return _source.load(std::memory_order_acquire);
+}
+
+}
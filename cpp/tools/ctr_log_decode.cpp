@@ -0,0 +1,162 @@
+/**
+ * Host side decoder for binary ring logs written by CTRE::Logging::BinaryRingLog.
+ *
+ * Build on the host with
+ *	g++ -std=c++14 -O2 -Icpp/include cpp/tools/ctr_log_decode.cpp -o ctr_log_decode
+ *
+ * Usage
+ *	ctr_log_decode [-e <robot program>] <log directory>		decode ctre_log_0.bin, ctre_log_1.bin, ...
+ *	ctr_log_decode [-e <robot program>] <segment file>...	decode the given segments
+ *
+ * Records from all segments are merged and printed oldest first, one per line:
+ *	seq time_s code origin: message | frame | frame ...
+ * Records lost to overwriting show up as a gap in seq and are reported.
+ * Stack frames are stored as raw addresses.  With -e they are symbolized by
+ * running addr2line on the robot program (the unstripped, non-PIE build that
+ * wrote the log), otherwise they are printed in hex.
+ */
+#include "ctre/phoenix/Logging/BinaryLogFormat.h"
+#include <algorithm>
+#include <map>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+using namespace CTRE::Logging;
+
+static bool ReadSegment(const std::string & path, std::vector<BinaryLogRecord> & records) {
+	FILE *f = fopen(path.c_str(), "rb");
+	if (f == nullptr)
+		return false;
+	BinaryLogSegmentHeader header;
+	if (fread(&header, 40, 1, f) != 1 || memcmp(header.magic, kBinaryLogMagic, sizeof(header.magic)) != 0) {
+		fprintf(stderr, "%s: not a binary ring log segment\n", path.c_str());
+		fclose(f);
+		return false;
+	}
+	if (header.recordSize != (uint32_t) kBinaryLogRecordSize) {
+		fprintf(stderr, "%s: version %u with %u byte records is not supported\n", path.c_str(), header.version,
+				header.recordSize);
+		fclose(f);
+		return false;
+	}
+	fseek(f, kBinaryLogRecordSize, SEEK_SET);
+	if (header.version != kBinaryLogVersion)
+		fprintf(stderr, "%s: version %u, expected %u, decoding anyway\n", path.c_str(), header.version, kBinaryLogVersion);
+
+	BinaryLogRecord rec;
+	for (uint32_t i = 0; i < header.recordsPerSegment; ++i) {
+		if (fread(&rec, sizeof(rec), 1, f) != 1)
+			break;
+		if (rec.seq != 0)
+			records.push_back(rec);
+	}
+	fclose(f);
+	return true;
+}
+
+/* Resolve every distinct frame address with one addr2line run */
+static void Symbolize(const char *program, const std::vector<BinaryLogRecord> & records,
+		std::map<uint64_t, std::string> & symbols) {
+	for (const BinaryLogRecord & rec : records) {
+		for (int i = 0; i < std::min<int>(rec.frameCount, kBinaryLogMaxFrames); ++i)
+			symbols[rec.frames[i]] = "";
+	}
+	if (symbols.empty())
+		return;
+
+	std::string command = "addr2line -f -C -p -e '" + std::string(program) + "'";
+	char address[24];
+	for (auto & symbol : symbols) {
+		snprintf(address, sizeof(address), " 0x%llx", (unsigned long long) symbol.first);
+		command += address;
+	}
+	FILE *pipe = popen(command.c_str(), "r");
+	if (pipe == nullptr) {
+		fprintf(stderr, "could not run addr2line, printing raw addresses\n");
+		return;
+	}
+	/* -p prints one line per address, in the order given */
+	char line[512];
+	for (auto & symbol : symbols) {
+		if (fgets(line, sizeof(line), pipe) == nullptr)
+			break;
+		line[strcspn(line, "\n")] = 0;
+		/* Leave unresolved frames empty so they print as addresses */
+		if (strncmp(line, "??", 2) != 0)
+			symbol.second = line;
+	}
+	pclose(pipe);
+}
+
+static bool IsDirectory(const char *path) {
+	struct stat st;
+	return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+int main(int argc, char **argv) {
+	const char *program = nullptr;
+	int first = 1;
+	if (argc > 2 && strcmp(argv[1], "-e") == 0) {
+		program = argv[2];
+		first = 3;
+	}
+	if (first >= argc) {
+		fprintf(stderr, "usage: %s [-e <robot program>] <log directory> | <segment file>...\n", argv[0]);
+		return 2;
+	}
+	std::vector<BinaryLogRecord> records;
+	if (argc == first + 1 && IsDirectory(argv[first])) {
+		for (int i = 0;; ++i) {
+			char name[32];
+			snprintf(name, sizeof(name), "/ctre_log_%d.bin", i);
+			std::string path = std::string(argv[first]) + name;
+			struct stat st;
+			if (stat(path.c_str(), &st) != 0)
+				break;
+			ReadSegment(path, records);
+		}
+	} else {
+		for (int i = first; i < argc; ++i)
+			ReadSegment(argv[i], records);
+	}
+
+	std::sort(records.begin(), records.end(), [](const BinaryLogRecord & a, const BinaryLogRecord & b) {
+		return a.seq < b.seq;
+	});
+	std::map<uint64_t, std::string> symbols;
+	if (program != nullptr)
+		Symbolize(program, records, symbols);
+
+	uint64_t expected = records.empty() ? 0 : records.front().seq;
+	if (expected > 1)
+		printf("# %llu older records overwritten\n", (unsigned long long) (expected - 1));
+	for (const BinaryLogRecord & rec : records) {
+		if (rec.seq != expected)
+			printf("# %llu records missing\n", (unsigned long long) (rec.seq - expected));
+		expected = rec.seq + 1;
+
+		unsigned int originLength = std::min<unsigned int>(rec.originLength, sizeof(rec.text));
+		unsigned int messageLength = std::min<unsigned int>(rec.messageLength, sizeof(rec.text) - originLength);
+		std::string message(rec.text + originLength, messageLength);
+		/* Keep one record per line */
+		while (message.empty() == false && message.back() == '\n')
+			message.pop_back();
+		for (int i = 0; i < std::min<int>(rec.frameCount, kBinaryLogMaxFrames); ++i) {
+			auto symbol = symbols.find(rec.frames[i]);
+			if (symbol != symbols.end() && symbol->second.empty() == false) {
+				message += " | " + symbol->second;
+			} else {
+				char address[24];
+				snprintf(address, sizeof(address), " | 0x%llx", (unsigned long long) rec.frames[i]);
+				message += address;
+			}
+		}
+		std::replace(message.begin(), message.end(), '\n', '|');
+		printf("%llu %.6f %d %.*s: %s\n", (unsigned long long) rec.seq, (double) rec.timestampNs * 1e-9, rec.code,
+				(int) originLength, rec.text, message.c_str());
+	}
+	return 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * Host side query tool for telemetry files written by CTRE::Telemetry::TelemetryRecorder.
+ *
+ * Build on the host with
+ *	g++ -std=c++14 -O2 -pthread -Icpp/include cpp/tools/ctr_tlm_query.cpp cpp/src/Telemetry/TelemetryReader.cpp -o ctr_tlm_query
+ *
+ * Usage
+ *	ctr_tlm_query <file> list
+ *	ctr_tlm_query <file> <motor|pigeon|canifier> <device number> <signal> [start_s end_s] [--changes]
+ *
+ * Times are seconds from the start of the recording.  Samples are printed
+ * as CSV, time_s,value.  --changes prints only rows where the value changed,
+ * handy for state and flag signals.
+ *
+ * Example, current of Talon 3 between 30 s and 45 s:
+ *	ctr_tlm_query match.tlm motor 3 OutputCurrent 30 45
+ */
+#include "ctre/phoenix/Telemetry/TelemetryReader.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace CTRE::Telemetry;
+
+static const char * TypeName(uint32_t type) {
+	switch (type) {
+		case MotorControllerDevice: return "motor";
+		case PigeonDevice: return "pigeon";
+		case CANifierDevice: return "canifier";
+	}
+	return "unknown";
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		fprintf(stderr, "usage: %s <file> list\n"
+				"       %s <file> <motor|pigeon|canifier> <device number> <signal> [start_s end_s] [--changes]\n",
+				argv[0], argv[0]);
+		return 2;
+	}
+	TelemetryReader reader;
+	if (reader.Open(argv[1]) == false) {
+		fprintf(stderr, "%s: not a telemetry file\n", argv[1]);
+		return 1;
+	}
+	double lengthSec = (reader.GetEndNs() - reader.GetStartNs()) * 1e-9;
+
+	if (strcmp(argv[2], "list") == 0) {
+		printf("# %d blocks, %.3f s\n", reader.GetBlockCount(), lengthSec);
+		for (int i = 0; i < reader.GetSignalCount(); ++i) {
+			const TelemetrySignalDesc & s = reader.GetSignal(i);
+			int number = (s.deviceType == MotorControllerDevice) ? (s.deviceId & 0x3F) : s.deviceId;
+			printf("%s %d %.*s\n", TypeName(s.deviceType), number, (int) sizeof(s.name), s.name);
+		}
+		return 0;
+	}
+	if (argc < 5) {
+		fprintf(stderr, "missing device number or signal\n");
+		return 2;
+	}
+
+	TelemetryDeviceType type;
+	if (strcmp(argv[2], "motor") == 0)
+		type = MotorControllerDevice;
+	else if (strcmp(argv[2], "pigeon") == 0)
+		type = PigeonDevice;
+	else if (strcmp(argv[2], "canifier") == 0)
+		type = CANifierDevice;
+	else {
+		fprintf(stderr, "unknown device type %s\n", argv[2]);
+		return 2;
+	}
+	int signal = reader.FindSignal(type, atoi(argv[3]), argv[4]);
+	if (signal < 0) {
+		fprintf(stderr, "%s %s has no signal %s, try list\n", argv[2], argv[3], argv[4]);
+		return 1;
+	}
+
+	double startSec = 0;
+	double endSec = lengthSec;
+	bool changes = false;
+	int positional = 0;
+	for (int i = 5; i < argc; ++i) {
+		if (strcmp(argv[i], "--changes") == 0)
+			changes = true;
+		else if (positional++ == 0)
+			startSec = atof(argv[i]);
+		else
+			endSec = atof(argv[i]);
+	}
+	int64_t t0 = reader.GetStartNs();
+	int64_t startNs = t0 + (int64_t) (startSec * 1e9);
+	int64_t endNs = t0 + (int64_t) (endSec * 1e9);
+
+	std::vector<TelemetryReader::Sample> samples;
+	bool ok = changes ? reader.QueryChanges(signal, startNs, endNs, samples) : reader.Query(signal, startNs, endNs, samples);
+	printf("time_s,%.*s\n", (int) sizeof(reader.GetSignal(signal).name), reader.GetSignal(signal).name);
+	for (auto & s : samples)
+		printf("%.6f,%.9g\n", (s.timestampNs - t0) * 1e-9, s.value);
+	if (ok == false) {
+		fprintf(stderr, "some blocks could not be decoded\n");
+		return 1;
+	}
+	return 0;
+}